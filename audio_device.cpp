@@ -92,18 +92,46 @@ static vector<char> readSoundData(OggVorbis_File& file, optional<int> length = n
   return ret;
 }
 
-SoundBuffer::SoundBuffer(const char* path) {
+bool AudioDevice::releaseBuffer(const SoundBuffer& buffer) {
+  RecursiveLock lock(mutex);
+  for (auto& source : sources) {
+    ALint bufferId = 0;
+    AL(alGetSourcei(source.getId(), AL_BUFFER, &bufferId));
+    if (bufferId == buffer.getBufferId()) {
+      ALint state = 0;
+      AL(alGetSourcei(source.getId(), AL_SOURCE_STATE, &state));
+      if (state == AL_PLAYING || state == AL_PAUSED)
+        return false;
+      AL(alSourcei(source.getId(), AL_BUFFER, 0));
+    }
+  }
+  return true;
+}
+
+DecodedSound::DecodedSound(const char* path) {
   OggVorbis_File file;
   CHECK(ov_fopen(path, &file) == 0) << "Error opening audio file: " << path;
   vorbis_info* info = ov_info(&file, -1);
+  channels = info->channels;
+  rate = info->rate;
   ov_raw_seek(&file, 0);
-  vector<char> buffer = readSoundData(file);
+  data = readSoundData(file);
+  ov_clear(&file);
+}
+
+int DecodedSound::getSize() const {
+  return data.size();
+}
+
+SoundBuffer::SoundBuffer(const char* path) : SoundBuffer(DecodedSound(path)) {
+}
+
+SoundBuffer::SoundBuffer(const DecodedSound& sound) {
   OpenalId id;
   AL(alGenBuffers(1, &id));
-  AL(alBufferData(id, (info->channels > 1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, buffer.data(), buffer.size(),
-      info->rate));
+  AL(alBufferData(id, (sound.channels > 1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16, sound.data.data(),
+      sound.data.size(), sound.rate));
   bufferId = id;
-  ov_clear(&file);
 }
 
 SoundBuffer::~SoundBuffer() {
@@ -7,9 +7,22 @@ struct vorbis_info;
 
 typedef unsigned int OpenalId;
 
+class DecodedSound {
+  public:
+  DecodedSound(const char* path);
+  int getSize() const;
+
+  private:
+  friend class SoundBuffer;
+  vector<char> data;
+  int channels;
+  long rate;
+};
+
 class SoundBuffer {
   public:
   SoundBuffer(const char* path);
+  SoundBuffer(const DecodedSound&);
   ~SoundBuffer();
   SoundBuffer(SoundBuffer&&);
 
@@ -59,6 +72,8 @@ class AudioDevice {
   optional<string> initialize();
   ~AudioDevice();
   void play(const SoundBuffer&, double volume, double pitch = 1);
+  // Detaches the buffer from all stopped sources. Returns false if it's still playing somewhere.
+  bool releaseBuffer(const SoundBuffer&);
 
   private:
   friend SoundStream;
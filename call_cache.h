@@ -2,55 +2,163 @@
 
 #include "stdafx.h"
 
+// Memoizes the results of generator calls, identified by a call site id and the arguments. The arguments are
+// stored with the result and compared on lookup, so different arguments never share a result even if their
+// hashes collide. Keeps at most maxSize results, evicting the least recently used one.
 template <typename Value>
 class CallCache {
   public:
-  CallCache(int size) : maxSize(size) {}
-
-  typedef pair<int, int> Key;
+  CallCache(int size) : maxSize(size), table(getTableSize(size), -1) {
+    nodes.reserve(maxSize);
+  }
 
   template <typename... Args, typename Generator>
   Value get(Generator gen, int id, Args&&...args) {
-    Key key = {id, combineHash(args...)};
-    if (auto elem = getValue(key))
-      return *elem;
-    else
-      return insertValue(key, gen(std::forward<Args>(args)...));
+    size_t hash = combineHash(id, args...);
+    int index = find(hash, id, args...);
+    if (index > -1) {
+      ++stats.hits;
+      moveToFront(index);
+      return nodes[index].value;
+    }
+    ++stats.misses;
+    // The key is copied before calling the generator, which may take the arguments by value.
+    unique_ptr<KeyBase> key(new Key<typename std::decay<Args>::type...>(args...));
+    Value value = gen(std::forward<Args>(args)...);
+    return nodes[insert(hash, id, std::move(key), std::move(value))].value;
   }
 
   int getSize() const {
-    return cache.size();
+    return nodes.size();
   }
 
   template <typename... Args>
   bool contains(int id, Args...args) {
-    return cache.count({id, combineHash(args...)});
+    return find(combineHash(id, args...), id, args...) > -1;
+  }
+
+  struct Stats {
+    long long hits;
+    long long misses;
+  };
+
+  const Stats& getStats() const {
+    return stats;
   }
 
   private:
-  Value& insertValue(Key key, Value value) {
-    if (cache.size() >= maxSize) {
-      CHECK(!lastUsed.isEmpty());
-      pair<const int, Key> lru = lastUsed.getFront2();
-      lastUsed.erase(lru.first);
-      cache.erase(lru.second);
+  struct KeyBase {
+    virtual ~KeyBase() {}
+  };
+
+  template <typename... Args>
+  struct Key : public KeyBase {
+    Key(const Args&... a) : args(a...) {}
+    std::tuple<Args...> args;
+  };
+
+  struct Node {
+    size_t hash;
+    int id;
+    unique_ptr<KeyBase> key;
+    Value value;
+    // Neighbors on the usage list, which starts with the most recently used node.
+    int prev;
+    int next;
+  };
+
+  static int getTableSize(int maxSize) {
+    int ret = 1;
+    while (ret < 2 * maxSize)
+      ret *= 2;
+    return ret;
+  }
+
+  int getMask() const {
+    return table.size() - 1;
+  }
+
+  template <typename... Args>
+  int find(size_t hash, int id, const Args&... args) const {
+    for (int slot = hash & getMask(); table[slot] > -1; slot = (slot + 1) & getMask()) {
+      auto& node = nodes[table[slot]];
+      if (node.hash == hash && node.id == id)
+        if (auto key = dynamic_cast<const Key<typename std::decay<Args>::type...>*>(node.key.get()))
+          if (key->args == std::tie(args...))
+            return table[slot];
+    }
+    return -1;
+  }
+
+  int insert(size_t hash, int id, unique_ptr<KeyBase> key, Value value) {
+    int index;
+    if (nodes.size() >= maxSize) {
+      CHECK(tail > -1);
+      index = tail;
+      unlink(index);
+      eraseFromTable(index);
+      nodes[index] = Node{hash, id, std::move(key), std::move(value), -1, -1};
+    } else {
+      index = nodes.size();
+      nodes.push_back(Node{hash, id, std::move(key), std::move(value), -1, -1});
     }
-    if (lastUsed.contains(key))
-      lastUsed.erase(key);
-    lastUsed.insert(key, ++cnt);
-    return cache[key] = value;
+    int slot = hash & getMask();
+    while (table[slot] > -1)
+      slot = (slot + 1) & getMask();
+    table[slot] = index;
+    pushFront(index);
+    return index;
   }
 
-  optional<Value&> getValue(Key key) {
-    if (auto elem = getMaybe(cache, key)) {
-      lastUsed.erase(key);
-      lastUsed.insert(key, ++cnt);
-      return *elem;
-    } else
-      return none;
+  // Removes the node from the linear probing table, shifting back the entries that probed past it.
+  void eraseFromTable(int index) {
+    int slot = nodes[index].hash & getMask();
+    while (table[slot] != index)
+      slot = (slot + 1) & getMask();
+    for (int next = (slot + 1) & getMask(); table[next] > -1; next = (next + 1) & getMask()) {
+      int home = nodes[table[next]].hash & getMask();
+      if (((next - home) & getMask()) >= ((next - slot) & getMask())) {
+        table[slot] = table[next];
+        slot = next;
+      }
+    }
+    table[slot] = -1;
   }
+
+  void unlink(int index) {
+    Node& node = nodes[index];
+    if (node.prev > -1)
+      nodes[node.prev].next = node.next;
+    else
+      head = node.next;
+    if (node.next > -1)
+      nodes[node.next].prev = node.prev;
+    else
+      tail = node.prev;
+    node.prev = node.next = -1;
+  }
+
+  void pushFront(int index) {
+    nodes[index].next = head;
+    if (head > -1)
+      nodes[head].prev = index;
+    head = index;
+    if (tail == -1)
+      tail = index;
+  }
+
+  void moveToFront(int index) {
+    if (index != head) {
+      unlink(index);
+      pushFront(index);
+    }
+  }
+
   const int maxSize;
-  unordered_map<Key, Value, CustomHash<Key>> cache;
-  BiMap<Key, int> lastUsed;
-  int cnt = 0;
+  vector<Node> nodes;
+  // Open addressing table of indices into nodes, -1 marks an empty slot.
+  vector<int> table;
+  int head = -1;
+  int tail = -1;
+  Stats stats = {0, 0};
 };
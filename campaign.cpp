@@ -50,7 +50,7 @@ void Campaign::clearSite(Vec2 v) {
   sites[v].viewId = {ViewId::GRASS};
 }
 
-vector<Campaign::VillainInfo> Campaign::getMainVillains() {
+vector<Campaign::VillainInfo> Campaign::getMainVillains(PlayerType playerType) {
   switch (playerType) {
     case KEEPER:
       return {
@@ -76,7 +76,7 @@ vector<Campaign::VillainInfo> Campaign::getMainVillains() {
   }
 }
 
-vector<Campaign::VillainInfo> Campaign::getLesserVillains() {
+vector<Campaign::VillainInfo> Campaign::getLesserVillains(PlayerType playerType) {
   switch (playerType) {
     case KEEPER:
       return {
@@ -101,7 +101,7 @@ vector<Campaign::VillainInfo> Campaign::getLesserVillains() {
   }
 }
 
-vector<Campaign::VillainInfo> Campaign::getAllies() {
+vector<Campaign::VillainInfo> Campaign::getAllies(PlayerType playerType) {
   switch (playerType) {
     case KEEPER:
       return {
@@ -130,6 +130,10 @@ void Campaign::setDefeated(Vec2 pos) {
   refreshInfluencePos();
 }
 
+vector<Campaign::VillainInfo> Campaign::getPossibleVillains(PlayerType playerType) {
+  return concat(getMainVillains(playerType), getLesserVillains(playerType), getAllies(playerType));
+}
+
 bool Campaign::VillainInfo::isEnemy() const {
   return type != VillainType::ALLY;
 }
@@ -299,15 +303,15 @@ optional<Campaign> Campaign::prepareCampaign(View* view, Options* options, Retir
     campaign.playerType = playerType;
     campaign.worldName = worldName;
     while (mainVillains.size() < limits.numMain)
-      append(mainVillains, random.permutation(campaign.getMainVillains()));
+      append(mainVillains, random.permutation(getMainVillains(playerType)));
     mainVillains.resize(limits.numMain);
     vector<VillainInfo> lesserVillains;
     while (lesserVillains.size() < limits.numLesser)
-      append(lesserVillains, random.permutation(campaign.getLesserVillains()));
+      append(lesserVillains, random.permutation(getLesserVillains(playerType)));
     lesserVillains.resize(limits.numLesser);
     vector<VillainInfo> allies;
     while (allies.size() < limits.numAllies)
-      append(allies, random.permutation(campaign.getAllies()));
+      append(allies, random.permutation(getAllies(playerType)));
     allies.resize(limits.numAllies);
     vector<Vec2> freePos;
     for (Vec2 v : Rectangle(size))
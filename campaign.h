@@ -51,6 +51,8 @@ class Campaign {
   const Table<SiteInfo>& getSites() const;
   void clearSite(Vec2);
   static optional<Campaign> prepareCampaign(View*, Options*, RetiredGames&&, RandomGen&, PlayerType);
+  // All villains that can be placed in a campaign of the given type, possibly with repetitions.
+  static vector<VillainInfo> getPossibleVillains(PlayerType);
   optional<Vec2> getPlayerPos() const;
   const string& getWorldName() const;
   bool isDefeated(Vec2) const;
@@ -72,9 +74,9 @@ class Campaign {
   private:
   void refreshInfluencePos();
   Campaign(Table<SiteInfo>, CampaignType);
-  vector<VillainInfo> getMainVillains();
-  vector<VillainInfo> getLesserVillains();
-  vector<VillainInfo> getAllies();
+  static vector<VillainInfo> getMainVillains(PlayerType);
+  static vector<VillainInfo> getLesserVillains(PlayerType);
+  static vector<VillainInfo> getAllies(PlayerType);
   Table<SiteInfo> SERIAL(sites);
   optional<Vec2> SERIAL(playerPos);
   string SERIAL(worldName);
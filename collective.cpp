@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "collective.h"
+#include "trace.h"
 #include "collective_control.h"
 #include "creature.h"
 #include "effect.h"
@@ -510,12 +511,38 @@ void Collective::setControl(PCollectiveControl c) {
   control = std::move(c);
 }
 
+bool Collective::isNearbyEnemy(const Creature* c) const {
+  return !c->isDead() && territory->isInExtended(c->getPosition(), 10) && getTribe()->isEnemy(c);
+}
+
+void Collective::updateNearbyEnemy(Creature* c) {
+  if (!nearbyEnemiesVersion)
+    return;
+  bool nearby = isNearbyEnemy(c);
+  bool wasNearby = contains(nearbyEnemies, c);
+  if (nearby && !wasNearby)
+    nearbyEnemies.push_back(c);
+  else if (!nearby && wasNearby)
+    removeElement(nearbyEnemies, c);
+}
+
 vector<Position> Collective::getEnemyPositions() const {
+  int version = territory->getExtendedVersion();
+  if (nearbyEnemiesVersion != version) {
+    nearbyEnemies.clear();
+    for (auto& area : territory->getExtendedBounds())
+      for (Creature* c : area.first->getAllCreatures(area.second))
+        if (isNearbyEnemy(c))
+          nearbyEnemies.push_back(c);
+    sort(nearbyEnemies.begin(), nearbyEnemies.end(),
+        [] (const Creature* c1, const Creature* c2) { return c1->getUniqueId() < c2->getUniqueId(); });
+    nearbyEnemiesVersion = version;
+  }
   vector<Position> enemyPos;
-  for (Position pos : territory->getExtended(10))
-    if (const Creature* c = pos.getCreature())
-      if (getTribe()->isEnemy(c))
-        enemyPos.push_back(pos);
+  // Creatures that left the level don't send an event, so they are filtered out here.
+  for (Creature* c : nearbyEnemies)
+    if (isNearbyEnemy(c))
+      enemyPos.push_back(c->getPosition());
   return enemyPos;
 }
 
@@ -568,6 +595,7 @@ void Collective::update(bool currentlyActive) {
 }
 
 void Collective::tick() {
+  TRACE_ZONE("Collective::tick");
   dangerLevelCache = none;
   control->tick();
   zones->tick();
@@ -703,6 +731,27 @@ void Collective::decreaseMoraleForBanishing(const Creature*) {
 void Collective::onKillCancelled(Creature* c) {
 }
 
+EnumSet<EventId> Collective::getSubscribedEvents() const {
+  return {EventId::ALARM, EventId::MOVED, EventId::KILLED, EventId::TORTURED, EventId::SURRENDERED,
+      EventId::TRAP_TRIGGERED, EventId::TRAP_DISARMED, EventId::FURNITURE_DESTROYED, EventId::CONQUERED_ENEMY};
+}
+
+EnumSet<EventId> Collective::getDeferredEvents() const {
+  return {};
+}
+
+bool Collective::isInAreaOfInterest(EventId id, Position pos) const {
+  switch (id) {
+    case EventId::ALARM:
+      return territory->contains(pos);
+    case EventId::MOVED:
+      // Enemies that left the area are filtered out in getEnemyPositions.
+      return !nearbyEnemiesVersion || territory->isInExtended(pos, 10);
+    default:
+      return true;
+  }
+}
+
 void Collective::onEvent(const GameEvent& event) {
   switch (event.getId()) {
     case EventId::ALARM: {
@@ -717,9 +766,14 @@ void Collective::onEvent(const GameEvent& event) {
         }
       }
       break;
+    case EventId::MOVED:
+      updateNearbyEnemy(event.get<Creature*>());
+      break;
     case EventId::KILLED: {
         Creature* victim = event.get<EventInfo::Attacked>().victim;
         Creature* killer = event.get<EventInfo::Attacked>().attacker;
+        if (contains(nearbyEnemies, victim))
+          removeElement(nearbyEnemies, victim);
         if (contains(creatures, victim))
           onMinionKilled(victim, killer);
         if (contains(creatures, killer))
@@ -875,7 +929,7 @@ int Collective::numResource(ResourceId id) const {
   if (auto itemIndex = config->getResourceInfo(id).itemIndex)
     if (auto storageType = config->getResourceInfo(id).storageDestination)
       for (Position pos : storageType(this))
-        ret += pos.getItems(*itemIndex).size();
+        ret += Item::getCount(pos.getItems(*itemIndex));
   return ret;
 }
 
@@ -915,8 +969,10 @@ void Collective::takeResource(const CostInfo& cost) {
       for (Position pos : storageType(this)) {
         vector<Item*> goldHere = pos.getItems(*itemIndex);
         for (Item* it : goldHere) {
-          pos.removeItem(it);
-          if (--num == 0)
+          int taken = min(num, it->getCount());
+          pos.removeItem(it, taken);
+          num -= taken;
+          if (num == 0)
             return;
         }
       }
@@ -995,10 +1051,10 @@ bool Collective::canPillage() const {
 int Collective::getNumItems(ItemIndex index, bool includeMinions) const {
   int ret = 0;
   for (Position v : territory->getAll())
-    ret += v.getItems(index).size();
+    ret += Item::getCount(v.getItems(index));
   if (includeMinions)
     for (Creature* c : getCreatures())
-      ret += c->getEquipment().getItems(index).size();
+      ret += Item::getCount(c->getEquipment().getItems(index));
   return ret;
 }
 
@@ -1263,32 +1319,41 @@ void Collective::updateConstructions() {
           Task::buildTorch(this, elem.first, elem.second.getAttachmentDir()), elem.first)->getUniqueId());
 }
 
-void Collective::delayDangerousTasks(const vector<Position>& enemyPos1, double delayTime) {
-  vector<Vec2> enemyPos = transform2<Vec2>(filter(enemyPos1,
-        [=] (const Position& p) { return p.isSameLevel(level); }),
-      [] (const Position& p) { return p.getCoord();});
+vector<Position> Collective::getDangerArea(Position enemyPos) const {
   int infinity = 1000000;
   int radius = 10;
-  Table<int> dist(Rectangle::boundingBox(enemyPos)
-      .minusMargin(-radius)
-      .intersection(getLevel()->getBounds()), infinity);
-  queue<Vec2> q;
-  for (Vec2 v : enemyPos) {
-    dist[v] = 0;
-    q.push(v);
-  }
-  while (!q.empty()) {
-    Vec2 pos = q.front();
-    q.pop();
-    delayedPos[Position(pos, level)] = delayTime;
+  Table<int> dist(Rectangle::centered(enemyPos.getCoord(), radius).intersection(getLevel()->getBounds()), infinity);
+  vector<Position> ret {enemyPos};
+  dist[enemyPos.getCoord()] = 0;
+  for (int i = 0; i < ret.size(); ++i) {
+    Vec2 pos = ret[i].getCoord();
     if (dist[pos] >= radius)
       continue;
     for (Vec2 v : pos.neighbors8())
       if (v.inRectangle(dist.getBounds()) && dist[v] == infinity && territory->contains(Position(v, level))) {
         dist[v] = dist[pos] + 1;
-        q.push(v);
+        ret.push_back(Position(v, level));
       }
   }
+  return ret;
+}
+
+void Collective::delayDangerousTasks(const vector<Position>& enemyPos, double delayTime) {
+  int version = territory->getExtendedVersion();
+  if (dangerAreasVersion != version) {
+    dangerAreas.clear();
+    dangerAreasVersion = version;
+  }
+  // The union of the areas around each enemy is the same as the area around all of them.
+  unordered_map<Position, vector<Position>, CustomHash<Position>> newAreas;
+  for (Position pos : enemyPos)
+    if (pos.isSameLevel(level) && !newAreas.count(pos)) {
+      auto cached = dangerAreas.find(pos);
+      auto& area = newAreas[pos] = cached != dangerAreas.end() ? std::move(cached->second) : getDangerArea(pos);
+      for (Position v : area)
+        delayedPos[v] = delayTime;
+    }
+  dangerAreas = std::move(newAreas);
 }
 
 bool Collective::isDelayed(Position pos) {
@@ -223,6 +223,9 @@ class Collective : public TaskCallback {
   HeapAllocated<EventProxy<Collective>> SERIAL(eventProxy);
   friend EventProxy<Collective>;
   void onEvent(const GameEvent&);
+  EnumSet<EventId> getSubscribedEvents() const;
+  EnumSet<EventId> getDeferredEvents() const;
+  bool isInAreaOfInterest(EventId, Position) const;
 
   friend class CollectiveBuilder;
   Collective(Level*, const CollectiveConfig&, TribeId, EnumMap<ResourceId, int> credit, const CollectiveName&);
@@ -301,6 +304,16 @@ class Collective : public TaskCallback {
   bool isDelayed(Position);
   unordered_map<Position, double, CustomHash<Position>> SERIAL(delayedPos);
   vector<Position> getEnemyPositions() const;
+  // Enemies in the extended territory. Rescanned using the level's creature index when the territory changes,
+  // and updated on MOVED and KILLED events otherwise.
+  mutable vector<Creature*> nearbyEnemies;
+  mutable optional<int> nearbyEnemiesVersion;
+  bool isNearbyEnemy(const Creature*) const;
+  void updateNearbyEnemy(Creature*);
+  // Squares delayed by each enemy position, reused while the enemy stays and the territory doesn't change.
+  unordered_map<Position, vector<Position>, CustomHash<Position>> dangerAreas;
+  optional<int> dangerAreasVersion;
+  vector<Position> getDangerArea(Position enemyPos) const;
   double manaRemainder = 0;
   double getKillManaScore(const Creature*) const;
   void addMana(double);
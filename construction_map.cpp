@@ -76,6 +76,8 @@ void ConstructionMap::removeFurniture(Position pos, FurnitureLayer layer) {
     addDebt(-info.getCost());
   }
   furniturePositions[type].erase(pos);
+  if (auto& index = furnitureIndex[type])
+    index->erase(pos);
   furniture[layer].erase(pos);
   removeElement(allFurniture, {pos, layer});
   pos.setNeedsRenderUpdate(true);
@@ -98,9 +100,11 @@ void ConstructionMap::addFurniture(Position pos, const FurnitureInfo& info) {
   allFurniture.push_back({pos, layer});
   furniture[layer].emplace(pos, info);
   pos.setNeedsRenderUpdate(true);
-  if (info.isBuilt())
+  if (info.isBuilt()) {
     furniturePositions[info.getFurnitureType()].insert(pos);
-  else {
+    if (auto& index = furnitureIndex[info.getFurnitureType()])
+      index->insert(pos);
+  } else {
     ++unbuiltCounts[info.getFurnitureType()];
     addDebt(info.getCost());
   }
@@ -122,6 +126,28 @@ const set<Position>& ConstructionMap::getBuiltPositions(FurnitureType type) cons
   return furniturePositions[type];
 }
 
+const PositionIndex& ConstructionMap::getFurnitureIndex(FurnitureType type) const {
+  auto& index = furnitureIndex[type];
+  if (!index) {
+    index = PositionIndex();
+    for (auto& pos : furniturePositions[type])
+      index->insert(pos);
+  }
+  return *index;
+}
+
+void ConstructionMap::getClosestBuilt(Position from, const vector<FurnitureType>& types, int margin,
+    const function<bool(Position)>& predicate, vector<Position>& result) const {
+  optional<int> minDist;
+  for (auto type : types)
+    if (auto dist = getFurnitureIndex(type).getClosestDist(from, predicate))
+      if (!minDist || *dist < *minDist)
+        minDist = *dist;
+  if (minDist)
+    for (auto type : types)
+      getFurnitureIndex(type).getWithin(from, *minDist + margin, predicate, result);
+}
+
 const vector<pair<Position, FurnitureLayer>>& ConstructionMap::getAllFurniture() const {
   return allFurniture;
 }
@@ -131,6 +157,8 @@ void ConstructionMap::onConstructed(Position pos, FurnitureType type) {
   if (!containsFurniture(pos, layer))
     addFurniture(pos, FurnitureInfo::getBuilt(type));
   furniturePositions[type].insert(pos);
+  if (auto& index = furnitureIndex[type])
+    index->insert(pos);
   --unbuiltCounts[type];
   if (furniture[layer].count(pos)) { // why this if?
     auto& info = furniture[layer].at(pos);
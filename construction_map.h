@@ -8,6 +8,7 @@
 #include "furniture_type.h"
 #include "furniture_layer.h"
 #include "resource_id.h"
+#include "position_index.h"
 
 class ConstructionMap {
   public:
@@ -82,6 +83,10 @@ class ConstructionMap {
   int getBuiltCount(FurnitureType) const;
   int getTotalCount(FurnitureType) const;
   const set<Position>& getBuiltPositions(FurnitureType) const;
+  // Appends built furniture of the given types that satisfies the predicate and is at most margin
+  // further from 'from' than the closest such furniture.
+  void getClosestBuilt(Position from, const vector<FurnitureType>&, int margin,
+      const function<bool(Position)>& predicate, vector<Position>& result) const;
   void onConstructed(Position, FurnitureType);
 
   const TrapInfo& getTrap(Position) const;
@@ -108,6 +113,9 @@ class ConstructionMap {
   FurnitureInfo& modFurniture(Position, FurnitureLayer);
   EnumMap<FurnitureLayer, map<Position, FurnitureInfo>> SERIAL(furniture);
   EnumMap<FurnitureType, set<Position>> SERIAL(furniturePositions);
+  // Built lazily from furniturePositions, so it doesn't need to be serialized.
+  mutable EnumMap<FurnitureType, optional<PositionIndex>> furnitureIndex;
+  const PositionIndex& getFurnitureIndex(FurnitureType) const;
   EnumMap<FurnitureType, int> SERIAL(unbuiltCounts);
   vector<pair<Position, FurnitureLayer>> SERIAL(allFurniture);
   map<Position, TrapInfo> SERIAL(traps);
@@ -16,6 +16,7 @@
 #include "stdafx.h"
 
 #include "creature.h"
+#include "trace.h"
 #include "creature_factory.h"
 #include "level.h"
 #include "ranged_weapon.h"
@@ -356,6 +357,7 @@ void Creature::swapPosition(Vec2 direction) {
 }
 
 void Creature::makeMove() {
+  TRACE_ZONE("Creature::makeMove");
   numAttacksThisTurn = 0;
   CHECK(!isDead());
   if (holding && holding->isDead())
@@ -483,8 +485,8 @@ CreatureAction Creature::pickUp(const vector<Item*>& items) const {
   return CreatureAction(this, [=](Creature* self) {
     INFO << getName().the() << " pickup ";
     for (auto stack : stackItems(items)) {
-      monsterMessage(getName().the() + " picks up " + getPluralAName(stack[0], stack.size()));
-      playerMessage("You pick up " + getPluralTheName(stack[0], stack.size()));
+      monsterMessage(getName().the() + " picks up " + getPluralAName(stack[0], Item::getCount(stack)));
+      playerMessage("You pick up " + getPluralTheName(stack[0], Item::getCount(stack)));
     }
     self->equipment->addItems(self->getPosition().removeItems(items));
     if (equipment->getTotalWeight() > getModifier(ModifierType::INV_LIMIT))
@@ -506,8 +508,8 @@ CreatureAction Creature::drop(const vector<Item*>& items) const {
   return CreatureAction(this, [=](Creature* self) {
     INFO << getName().the() << " drop";
     for (auto stack : stackItems(items)) {
-      monsterMessage(getName().the() + " drops " + getPluralAName(stack[0], stack.size()));
-      playerMessage("You drop " + getPluralTheName(stack[0], stack.size()));
+      monsterMessage(getName().the() + " drops " + getPluralAName(stack[0], Item::getCount(stack)));
+      playerMessage("You drop " + getPluralTheName(stack[0], Item::getCount(stack)));
     }
     getGame()->addEvent({EventId::DROPPED, EventInfo::ItemsHandled{self, items}});
     self->getPosition().dropItems(self->equipment->removeItems(items));
@@ -840,14 +842,9 @@ bool Creature::isEnemy(const Creature* c) const {
     privateEnemies.contains(c) || c->privateEnemies.contains(this);
 }
 
-vector<Item*> Creature::getGold(int num) const {
-  vector<Item*> ret;
-  for (Item* item : equipment->getItems([](Item* it) { return it->getClass() == ItemClass::GOLD; })) {
-    ret.push_back(item);
-    if (ret.size() == num)
-      return ret;
-  }
-  return ret;
+vector<Item*> Creature::getGold(int num) {
+  return equipment->takeFromStacks(
+      equipment->getItems([](Item* it) { return it->getClass() == ItemClass::GOLD; }), num);
 }
 
 void Creature::setPosition(Position pos) {
@@ -1256,10 +1253,10 @@ CreatureAction Creature::give(Creature* whom, vector<Item*> items) {
   return CreatureAction(this, [=](Creature* self) {
     for (auto stack : stackItems(items)) {
       if (!whom->isPlayer())
-        monsterMessage(getName().the() + " gives " + getPluralAName(stack[0], stack.size()) + " to " +
+        monsterMessage(getName().the() + " gives " + getPluralAName(stack[0], Item::getCount(stack)) + " to " +
             whom->getName().the());
-      whom->playerMessage(getName().the() + " gives you " + getPluralAName(stack[0], stack.size()));
-      playerMessage("You give " + getPluralTheName(stack[0], stack.size()) + " to " +
+      whom->playerMessage(getName().the() + " gives you " + getPluralAName(stack[0], Item::getCount(stack)));
+      playerMessage("You give " + getPluralTheName(stack[0], Item::getCount(stack)) + " to " +
         whom->getName().the());
     }
     whom->takeItems(equipment->removeItems(items), this);
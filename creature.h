@@ -114,7 +114,7 @@ class Creature : public Renderable, public UniqueEntity<Creature> {
   void setTribe(TribeId);
   bool isFriend(const Creature*) const;
   int getDebt(const Creature* debtor) const;
-  vector<Item*> getGold(int num) const;
+  vector<Item*> getGold(int num);
 
   void takeItems(vector<PItem> items, const Creature* from);
   bool canTakeItems(const vector<Item*>& items) const;
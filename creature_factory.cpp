@@ -455,7 +455,7 @@ class ShopkeeperController : public Monster {
   }
 
   virtual void onItemsGiven(vector<Item*> items, const Creature* from) override {
-    int paid = filter(items, Item::classPredicate(ItemClass::GOLD)).size();
+    int paid = Item::getCount(filter(items, Item::classPredicate(ItemClass::GOLD)));
     if ((debt[from] -= paid) <= 0)
       debt.erase(from);
     for (Item* it : from->getEquipment().getItems())
@@ -465,6 +465,18 @@ class ShopkeeperController : public Monster {
       }
   }
   
+  EnumSet<EventId> getSubscribedEvents() const {
+    return {EventId::ITEMS_APPEARED, EventId::PICKED_UP, EventId::DROPPED};
+  }
+
+  EnumSet<EventId> getDeferredEvents() const {
+    return {};
+  }
+
+  bool isInAreaOfInterest(EventId, Position pos) const {
+    return shopArea->contains(pos);
+  }
+
   void onEvent(const GameEvent& event) {
     switch (event.getId()) {
       case EventId::ITEMS_APPEARED: {
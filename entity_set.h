@@ -50,6 +50,10 @@ class EntitySet {
     return combineHashIter(elems.begin(), elems.end());
   }
 
+  bool operator == (const EntitySet& other) const {
+    return elems == other.elems;
+  }
+
   private:
   set<typename UniqueEntity<T>::Id> SERIAL(elems);
 };
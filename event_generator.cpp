@@ -11,11 +11,17 @@ EventGenerator<Listener>::~EventGenerator<Listener>() {
 template<typename Listener>
 void EventGenerator<Listener>::addListener(Listener* l) {
   listeners.push_back(l);
+  subscribersValid = false;
 }
 
 template<typename Listener>
 void EventGenerator<Listener>::removeListener(Listener* l) {
   removeElement(listeners, l);
+  subscribersValid = false;
+  deferred = filter(deferred, [&] (const pair<Listener*, Event>& elem) { return elem.first != l; });
+  for (auto& elem : processing)
+    if (elem.first == l)
+      elem.first = nullptr;
 }
 
 template<typename Listener>
@@ -23,6 +29,56 @@ const vector<Listener*> EventGenerator<Listener>::getListeners() const {
   return listeners;
 }
 
+template<typename Listener>
+void EventGenerator<Listener>::updateSubscribers() {
+  // The subscriptions are not serialized, so after loading they are rebuilt on the first event.
+  if (subscribersValid)
+    return;
+  for (Id id : ENUM_ALL(Id)) {
+    subscribers[id].clear();
+    deferredSubscribers[id].clear();
+  }
+  for (Listener* l : listeners) {
+    auto deferredEvents = l->getDeferredEvents();
+    for (Id id : l->getSubscribedEvents())
+      (deferredEvents.contains(id) ? deferredSubscribers : subscribers)[id].push_back(l);
+  }
+  subscribersValid = true;
+}
+
+template<typename Listener>
+void EventGenerator<Listener>::deliver(const vector<Listener*>& to, const Event& event, bool defer) {
+  if (to.empty())
+    return;
+  Id id = event.getId();
+  auto position = event.getPosition();
+  // A listener may unsubscribe while handling the event, so a copy is iterated.
+  for (Listener* l : copyOf(to))
+    if (!position || l->isInAreaOfInterest(id, *position)) {
+      if (defer)
+        deferred.emplace_back(l, event);
+      else
+        l->onEvent(event);
+    }
+}
+
+template<typename Listener>
+void EventGenerator<Listener>::addEvent(const Event& event) {
+  updateSubscribers();
+  deliver(subscribers[event.getId()], event, false);
+  deliver(deferredSubscribers[event.getId()], event, true);
+}
+
+template<typename Listener>
+void EventGenerator<Listener>::processDeferred() {
+  CHECK(processing.empty());
+  processing.swap(deferred);
+  for (auto& elem : processing)
+    if (elem.first)
+      elem.first->onEvent(elem.second);
+  processing.clear();
+}
+
 template <class Listener>
 template <class Archive> 
 void EventGenerator<Listener>::serialize(Archive& ar, const unsigned int version) {
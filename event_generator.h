@@ -5,9 +5,17 @@
 template <typename Listener>
 class EventGenerator {
   public:
+  typedef typename Listener::Event Event;
+  typedef typename Listener::Id Id;
+
   ~EventGenerator();
   const vector<Listener*> getListeners() const;
 
+  // Delivers the event to the listeners that subscribed to its id and whose area of interest contains it.
+  void addEvent(const Event&);
+  // Delivers the events queued for listeners that subscribed to them as deferred.
+  void processDeferred();
+
   template <class Archive> 
   void serialize(Archive& ar, const unsigned int version);
 
@@ -15,8 +23,14 @@ class EventGenerator {
   friend Listener;
   void addListener(Listener*);
   void removeListener(Listener*);
+  void updateSubscribers();
+  void deliver(const vector<Listener*>&, const Event&, bool defer);
   vector<Listener*> SERIAL(listeners);
+  // Built from the listeners' subscriptions, so that events don't reach listeners that ignore them.
+  EnumMap<Id, vector<Listener*>> subscribers;
+  EnumMap<Id, vector<Listener*>> deferredSubscribers;
+  bool subscribersValid = false;
+  vector<pair<Listener*, Event>> deferred;
+  vector<pair<Listener*, Event>> processing;
 };
 
-
-
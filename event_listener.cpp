@@ -5,6 +5,7 @@
 #include "player_control.h"
 #include "village_control.h"
 #include "player.h"
+#include "creature.h"
 
 EventListener::EventListener() {
 }
@@ -29,6 +30,42 @@ EventListener::~EventListener() {
   unsubscribe();
 }
 
+EnumSet<EventId> EventListener::getSubscribedEvents() const {
+  return EnumSet<EventId>::fullSet();
+}
+
+EnumSet<EventId> EventListener::getDeferredEvents() const {
+  return {};
+}
+
+bool EventListener::isInAreaOfInterest(EventId, Position) const {
+  return true;
+}
+
+optional<Position> GameEvent::getPosition() const {
+  switch (getId()) {
+    case EventId::MOVED:
+      return get<Creature*>()->getPosition();
+    case EventId::EXPLOSION:
+    case EventId::ALARM:
+    case EventId::TRAP_TRIGGERED:
+    case EventId::POSITION_DISCOVERED:
+      return get<Position>();
+    case EventId::PICKED_UP:
+    case EventId::DROPPED:
+    case EventId::EQUIPED:
+      return get<EventInfo::ItemsHandled>().creature->getPosition();
+    case EventId::ITEMS_APPEARED:
+      return get<EventInfo::ItemsAppeared>().position;
+    case EventId::TRAP_DISARMED:
+      return get<EventInfo::TrapDisarmed>().position;
+    case EventId::FURNITURE_DESTROYED:
+      return get<EventInfo::FurnitureEvent>().position;
+    default:
+      return none;
+  }
+}
+
 SERIALIZE_DEF(EventListener, generator);
 
 
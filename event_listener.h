@@ -9,7 +9,7 @@ class Model;
 class Technology;
 class Collective;
 
-enum class EventId {
+RICH_ENUM(EventId,
   MOVED,
   KILLED,
   PICKED_UP,
@@ -29,7 +29,7 @@ enum class EventId {
   EQUIPED,
   CREATURE_EVENT,
   POSITION_DISCOVERED
-};
+);
 
 namespace EventInfo {
 
@@ -87,11 +87,17 @@ class GameEvent : public EnumVariant<EventId, TYPES(Creature*, Position, Technol
     ASSIGN(EventInfo::TrapDisarmed, EventId::TRAP_DISARMED),
     ASSIGN(EventInfo::FurnitureEvent, EventId::FURNITURE_DESTROYED) > {
   using EnumVariant::EnumVariant;
+
+  public:
+  // Where the event happened, for events that are tied to a position.
+  optional<Position> getPosition() const;
 };
 
 class EventListener {
   public:
   typedef EventGenerator<EventListener> Generator;
+  typedef GameEvent Event;
+  typedef EventId Id;
 
   EventListener();
   EventListener(Model*);
@@ -104,6 +110,13 @@ class EventListener {
 
   virtual void onEvent(const GameEvent&) = 0;
 
+  // Only these events are delivered. The set must not change while the listener is subscribed.
+  virtual EnumSet<EventId> getSubscribedEvents() const;
+  // Subset of the subscribed events that are queued and delivered once per turn instead of immediately.
+  virtual EnumSet<EventId> getDeferredEvents() const;
+  // Positional events that happen outside of the listener's area of interest are not delivered.
+  virtual bool isInAreaOfInterest(EventId, Position) const;
+
   template <class Archive> 
   void serialize(Archive& ar, const unsigned int version);
 
@@ -21,6 +21,18 @@ class EventProxy : public EventListener {
     owner->onEvent(e);
   }
 
+  virtual EnumSet<EventId> getSubscribedEvents() const override {
+    return owner->getSubscribedEvents();
+  }
+
+  virtual EnumSet<EventId> getDeferredEvents() const override {
+    return owner->getDeferredEvents();
+  }
+
+  virtual bool isInAreaOfInterest(EventId id, Position pos) const override {
+    return owner->isInAreaOfInterest(id, pos);
+  }
+
   virtual ~EventProxy() {}
 
   private:
@@ -16,6 +16,7 @@
 #include "stdafx.h"
 
 #include "field_of_view.h"
+#include "trace.h"
 #include "square.h"
 #include "square_array.h"
 #include "square_type.h"
@@ -100,6 +101,7 @@ const vector<Vec2>& FieldOfView::Visibility::getVisibleTiles() const {
 
 const vector<Vec2>& FieldOfView::getVisibleTiles(Vec2 from) {
   if (!visibility[from]) {
+    TRACE_ZONE("FieldOfView");
     visibility[from].reset(new Visibility(level, vision, from.x, from.y));
   }
   return visibility[from]->getVisibleTiles();
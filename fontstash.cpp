@@ -709,6 +709,50 @@ void sth_draw_text(struct sth_stash* stash,
 	if (dx) *dx = x;
 }
 
+int sth_get_text_quads(struct sth_stash* stash,
+					   int idx, float size,
+					   float x, float y,
+					   const char* s, struct sth_glyph_quad* quads)
+{
+	unsigned int codepoint;
+	struct sth_glyph* glyph = NULL;
+	unsigned int state = 0;
+	struct sth_quad q;
+	short isize = (short)(size*10.0f);
+	struct sth_font* fnt = NULL;
+	int n = 0;
+
+	if (stash == NULL)
+        return 0;
+	fnt = stash->fonts;
+	while(fnt != NULL && fnt->idx != idx) fnt = fnt->next;
+	if (fnt == NULL)
+        return 0;
+	if (fnt->type != BMFONT && !fnt->data)
+        return 0;
+	for (; *s; ++s)
+	{
+		if (decutf8(&state, &codepoint, *(unsigned char*)s))
+            continue;
+		glyph = get_glyph(stash, fnt, codepoint, isize);
+		if (!glyph)
+            continue;
+		if (!get_quad(stash, fnt, glyph, isize, &x, &y, &q))
+            continue;
+		quads[n].texture = glyph->texture->id;
+		quads[n].x0 = q.x0;
+		quads[n].y0 = q.y0;
+		quads[n].x1 = q.x1;
+		quads[n].y1 = q.y1;
+		quads[n].s0 = glyph->x0;
+		quads[n].t0 = glyph->y0;
+		quads[n].s1 = glyph->x1;
+		quads[n].t1 = glyph->y1;
+		++n;
+	}
+	return n;
+}
+
 void sth_dim_text(struct sth_stash* stash,
 				  int idx, float size,
 				  const char* s,
@@ -51,6 +51,19 @@ void sth_draw_text(struct sth_stash* stash,
 				   int idx, float size,
 				   float x, float y, const char* string, float* dx);
 
+struct sth_glyph_quad
+{
+	SDL::GLuint texture;
+	float x0,y0,x1,y1;
+	// In pixels of the glyph cache texture.
+	int s0,t0,s1,t1;
+};
+
+// Fills quads with the glyphs that sth_draw_text would draw, without drawing them. Quads must have room for
+// strlen(string) elements. Returns the number of quads.
+int sth_get_text_quads(struct sth_stash* stash, int idx, float size,
+					   float x, float y, const char* string, struct sth_glyph_quad* quads);
+
 void sth_dim_text(struct sth_stash* stash, int idx, float size, const char* string,
 				  float* minx, float* miny, float* maxx, float* maxy);
 
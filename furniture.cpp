@@ -181,6 +181,10 @@ bool Furniture::isTicking() const {
   return !!tickType;
 }
 
+bool Furniture::needsTick() const {
+  return isTicking() || (getFire() && getFire()->isBurning());
+}
+
 bool Furniture::isWall() const {
   return wall;
 }
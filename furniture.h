@@ -49,6 +49,8 @@ class Furniture : public Renderable {
   int getUsageTime() const;
   optional<FurnitureClickType> getClickType() const;
   bool isTicking() const;
+  // Whether tick() can change anything, because the furniture is burning or has a tick type.
+  bool needsTick() const;
   bool isWall() const;
   void onConstructedBy(Creature*) const;
   FurnitureLayer getLayer() const;
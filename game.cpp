@@ -251,13 +251,17 @@ optional<Game::ExitInfo> Game::update(double timeDiff) {
 
 optional<Game::ExitInfo> Game::updateModel(Model* model, double totalTime) {
   auto absoluteTime = view->getTimeMilliAbsolute();
-  if (!lastUpdate || absoluteTime - *lastUpdate > milliseconds{10}) {
+  // In turbo mode the player's view is rendered and input is polled only a few times per second,
+  // so that the simulation gets most of the time.
+  bool turbo = view->isTurboMode() && !view->isClockStopped();
+  if (!lastUpdate || absoluteTime - *lastUpdate > (turbo ? milliseconds{250} : milliseconds{10})) {
     if (playerControl)
       playerControl->render(view);
     if (spectator)
       view->updateView(spectator.get(), false);
     lastUpdate = absoluteTime;
   } 
+  bool pollInput = true;
   do {
     if (spectator)
       while (1) {
@@ -267,7 +271,8 @@ optional<Game::ExitInfo> Game::updateModel(Model* model, double totalTime) {
         if (input.getId() == UserInputId::IDLE)
           break;
       }
-    if (playerControl && !playerControl->isTurnBased()) {
+    if (playerControl && !playerControl->isTurnBased() && pollInput) {
+      pollInput = !turbo;
       while (1) {
         UserInput input = view->getAction();
         if (input.getId() == UserInputId::IDLE)
@@ -279,8 +284,13 @@ optional<Game::ExitInfo> Game::updateModel(Model* model, double totalTime) {
           return exitInfo;
       }
     }
-    if (model->getLocalTime() >= totalTime)
+    if (model->getLocalTime() >= totalTime) {
+      // Deferred events and vision are processed once per slice, before the view is refreshed.
+      model->processDeferredEvents();
+      if (playerControl)
+        playerControl->updateVisibility();
       return none;
+    }
     model->update(totalTime);
     if (exitInfo)
       return exitInfo;
@@ -145,8 +145,21 @@ struct ImmigrantDataInfo {
   HASH_ALL(requirements, name, viewId, expLevel, count, timeLeft, id, autoState, cost)
 };
 
+// Parts of CollectiveInfo that are expensive to generate. Each is only regenerated when the state it shows
+// might have changed, which is signaled by a new version number.
+RICH_ENUM(GameInfoSection,
+  VILLAGES,
+  MINIONS,
+  IMMIGRANTS,
+  IMMIGRATION_HELP,
+  WORKSHOP,
+  BUILDINGS,
+  TASKS
+);
+
 class CollectiveInfo {
   public:
+  EnumMap<GameInfoSection, int> HASH(sectionVersions);
   string HASH(warning);
   struct Button {
     ViewId HASH(viewId);
@@ -246,7 +259,8 @@ class CollectiveInfo {
   };
   optional<Ransom> HASH(ransom);
 
-  HASH_ALL(warning, buildings, minionButtons, libraryButtons, minionCount, minionLimit, monsterHeader, minions, minionGroups, enemyGroups, chosenCreature, numResource, teams, nextPayout, payoutTimeRemaining, techButtons, taskMap, ransom, chosenWorkshop, workshopButtons, immigration, allImmigration);
+  // The versioned sections are represented by their versions, so that hashing doesn't walk them.
+  HASH_ALL(sectionVersions, warning, minionButtons, enemyGroups, numResource, nextPayout, payoutTimeRemaining, ransom);
 };
 
 class VillageInfo {
@@ -302,5 +316,6 @@ class GameInfo {
   GameSunlightInfo HASH(sunlightInfo);
 
   vector<PlayerMessage> HASH(messageBuffer);
-  HASH_ALL(infoType, time, collectiveInfo, playerInfo, villageInfo, sunlightInfo, messageBuffer, singleModel, modifiedSquares, totalSquares);
+  // The villages are covered by the collectiveInfo section versions.
+  HASH_ALL(infoType, time, collectiveInfo, playerInfo, sunlightInfo, messageBuffer, singleModel, modifiedSquares, totalSquares);
 };
@@ -220,7 +220,7 @@ SGuiElem GuiBuilder::drawButtons(vector<CollectiveInfo::Button> buttons, Collect
 }
 
 SGuiElem GuiBuilder::drawBuildings(const CollectiveInfo& info) {
-  int newHash = combineHash(info.buildings);
+  int newHash = info.sectionVersions[GameInfoSection::BUILDINGS];
   if (newHash != buildingsHash) {
     buildingsCache =  gui.scrollable(drawButtons(info.buildings, CollectiveTab::BUILDINGS),
         &buildingsScroll, &scrollbarsHeld);
@@ -230,7 +230,8 @@ SGuiElem GuiBuilder::drawBuildings(const CollectiveInfo& info) {
 }
 
 SGuiElem GuiBuilder::drawTechnology(CollectiveInfo& info) {
-  int hash = combineHash(info.techButtons, info.workshopButtons, info.libraryButtons);
+  int hash = combineHash(info.sectionVersions[GameInfoSection::BUILDINGS],
+      info.sectionVersions[GameInfoSection::WORKSHOP]);
   if (hash != technologyHash) {
     technologyHash = hash;
     auto lines = gui.getListBuilder(legendLineHeight);
@@ -359,6 +360,7 @@ const char* GuiBuilder::getGameSpeedName(GuiBuilder::GameSpeed gameSpeed) const
     case GameSpeed::NORMAL: return "normal";
     case GameSpeed::FAST: return "fast";
     case GameSpeed::VERY_FAST: return "very fast";
+    case GameSpeed::TURBO: return "turbo";
   }
 }
 
@@ -370,7 +372,7 @@ const char* GuiBuilder::getCurrentGameSpeedName() const {
 }
 
 SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
-  int hash = combineHash(info.collectiveInfo, info.villageInfo, info.modifiedSquares, info.totalSquares);
+  int hash = combineHash(info.collectiveInfo, info.modifiedSquares, info.totalSquares);
   if (hash != rightBandInfoHash) {
     rightBandInfoHash = hash;
     CollectiveInfo& collectiveInfo = info.collectiveInfo;
@@ -427,7 +429,7 @@ SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
     int totalSquares = info.totalSquares;
     bottomLine.addElemAuto(
         gui.labelFun([=]()->string {
-            return "FPS " + toString(fpsCounter.getFps()) + " / " + toString(upsCounter.getFps());
+            return "FPS " + toString(fpsCounter.getFps()) + " / " + toString(upsCounter.getFps()) + getCacheStats();
                 //+ " SMOD " + toString(modifiedSquares) + "/" + toString(totalSquares);
         },
         colors[ColorId::WHITE]));
@@ -438,6 +440,15 @@ SGuiElem GuiBuilder::drawRightBandInfo(GameInfo& info) {
   return gui.external(rightBandInfoCache.get());
 }
 
+string GuiBuilder::getCacheStats() const {
+#ifndef RELEASE
+  auto& stats = cache->getStats();
+  if (auto total = stats.hits + stats.misses)
+    return " GUI cache " + toString(stats.hits * 100 / total) + "%";
+#endif
+  return "";
+}
+
 GuiBuilder::GameSpeed GuiBuilder::getGameSpeed() const {
   return gameSpeed;
 }
@@ -456,6 +467,7 @@ static SDL_Keycode getHotkey(GuiBuilder::GameSpeed speed) {
     case GuiBuilder::GameSpeed::NORMAL: return SDL::SDLK_2;
     case GuiBuilder::GameSpeed::FAST: return SDL::SDLK_3;
     case GuiBuilder::GameSpeed::VERY_FAST: return SDL::SDLK_4;
+    case GuiBuilder::GameSpeed::TURBO: return SDL::SDLK_5;
   }
 }
 
@@ -1466,25 +1478,30 @@ SGuiElem GuiBuilder::drawBuildingsOverlay(const CollectiveInfo& info) {
 
 void GuiBuilder::drawOverlays(vector<OverlayInfo>& ret, GameInfo& info) {
   switch (info.infoType) {
-    case GameInfo::InfoType::BAND:
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawImmigrationOverlay, this), THIS_LINE,
-           info.collectiveInfo), OverlayInfo::IMMIGRATION});
+    case GameInfo::InfoType::BAND: {
+      // The overlays are keyed on the versions of the sections they show, instead of hashing their contents.
+      auto& collectiveInfo = info.collectiveInfo;
+      auto version = [&] (GameInfoSection section) { return collectiveInfo.sectionVersions[section]; };
+      ret.push_back({cache->get([&] (int) { return drawImmigrationOverlay(collectiveInfo); }, THIS_LINE,
+           version(GameInfoSection::IMMIGRANTS)), OverlayInfo::IMMIGRATION});
       ret.push_back({cache->get(bindMethod(&GuiBuilder::drawRansomOverlay, this), THIS_LINE,
            info.collectiveInfo.ransom), OverlayInfo::TOP_LEFT});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawMinionsOverlay, this), THIS_LINE,
-           info.collectiveInfo), OverlayInfo::MINIONS});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawWorkshopsOverlay, this), THIS_LINE,
-           info.collectiveInfo), OverlayInfo::MINIONS});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawTasksOverlay, this), THIS_LINE,
-           info.collectiveInfo), OverlayInfo::TOP_LEFT});
-      ret.push_back({cache->get(bindMethod(&GuiBuilder::drawBuildingsOverlay, this), THIS_LINE,
-           info.collectiveInfo), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->get([&] (int) { return drawMinionsOverlay(collectiveInfo); }, THIS_LINE,
+           version(GameInfoSection::MINIONS)), OverlayInfo::MINIONS});
+      ret.push_back({cache->get([&] (int) { return drawWorkshopsOverlay(collectiveInfo); }, THIS_LINE,
+           version(GameInfoSection::WORKSHOP)), OverlayInfo::MINIONS});
+      ret.push_back({cache->get([&] (int, int) { return drawTasksOverlay(collectiveInfo); }, THIS_LINE,
+           version(GameInfoSection::TASKS), version(GameInfoSection::MINIONS)), OverlayInfo::TOP_LEFT});
+      ret.push_back({cache->get([&] (int, const optional<CollectiveInfo::Ransom>&) {
+              return drawBuildingsOverlay(collectiveInfo); }, THIS_LINE,
+           version(GameInfoSection::BUILDINGS), collectiveInfo.ransom), OverlayInfo::TOP_LEFT});
       if (immigrantHelpOpen)
-        ret.push_back({cache->get(bindMethod(&GuiBuilder::drawImmigrationHelp, this), THIS_LINE,
-            info.collectiveInfo), OverlayInfo::BOTTOM_LEFT});
+        ret.push_back({cache->get([&] (int) { return drawImmigrationHelp(collectiveInfo); }, THIS_LINE,
+            version(GameInfoSection::IMMIGRATION_HELP)), OverlayInfo::BOTTOM_LEFT});
       ret.push_back({cache->get(bindMethod(&GuiBuilder::drawGameSpeedDialog, this), THIS_LINE),
            OverlayInfo::GAME_SPEED});
       break;
+    }
     case GameInfo::InfoType::PLAYER:
       ret.push_back({cache->get(bindMethod(&GuiBuilder::drawPlayerOverlay, this), THIS_LINE,
            info.playerInfo), OverlayInfo::TOP_LEFT});
@@ -218,6 +218,7 @@ class GuiBuilder {
   bool immigrantHelpOpen = false;
   atomic<GameSpeed> gameSpeed;
   const char* getGameSpeedName(GameSpeed) const;
+  string getCacheStats() const;
   const char* getCurrentGameSpeedName() const;
 
   class FpsCounter {
@@ -269,6 +270,7 @@ RICH_ENUM(GuiBuilder::GameSpeed,
   SLOW,
   NORMAL,
   FAST,
-  VERY_FAST
+  VERY_FAST,
+  TURBO
 );
 
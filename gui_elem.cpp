@@ -35,7 +35,10 @@ Rectangle GuiElem::getBounds() {
 }
 
 void GuiElem::setBounds(Rectangle b) {
+  if (boundsSet && b == bounds && isStatic())
+    return;
   bounds = b;
+  boundsSet = true;
   onRefreshBounds();
 }
 
@@ -50,6 +53,10 @@ class Button : public GuiElem {
   public:
   Button(function<void(Rectangle)> f) : fun(f) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual bool onLeftClick(Vec2 pos) override {
     if (pos.inRectangle(getBounds())) {
       fun(getBounds());
@@ -66,6 +73,10 @@ class ReleaseButton : public GuiElem {
   public:
   ReleaseButton(function<void()> f, int but) : fun(f), button(but) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual void onMouseRelease(Vec2 pos) override {
     if (clicked && pos.inRectangle(getBounds()))
       fun();
@@ -205,6 +216,10 @@ class ButtonRightClick : public GuiElem {
   public:
   ButtonRightClick(function<void(Rectangle)> f) : fun(f) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual bool onRightClick(Vec2 pos) override {
     if (pos.inRectangle(getBounds())) {
       fun(getBounds());
@@ -234,6 +249,10 @@ class ReverseButton : public GuiElem {
   public:
   ReverseButton(function<void()> f, bool cap) : fun(f), capture(cap) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual bool onLeftClick(Vec2 pos) override {
     if (!pos.inRectangle(getBounds())) {
       fun();
@@ -258,6 +277,10 @@ class MouseWheel : public GuiElem {
   public:
   MouseWheel(function<void(bool)> f) : fun(f) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual bool onMouseWheel(Vec2 mousePos, bool up) override {
     if (mousePos.inRectangle(getBounds())) {
       fun(up);
@@ -276,6 +299,10 @@ SGuiElem GuiFactory::mouseWheel(function<void(bool)> fun) {
 
 class StopMouseMovement : public GuiElem {
   public:
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual bool onMouseMove(Vec2 pos) override {
     return pos.inRectangle(getBounds());
   }
@@ -300,12 +327,17 @@ SGuiElem GuiFactory::stopMouseMovement() {
 class DrawCustom : public GuiElem {
   public:
   typedef function<void(Renderer&, Rectangle)> DrawFun;
-  DrawCustom(DrawFun draw, function<int()> width = nullptr) : drawFun(draw), preferredWidth(width) {}
+  DrawCustom(DrawFun draw, function<int()> width = nullptr, bool stat = false)
+      : drawFun(draw), preferredWidth(width), constant(stat) {}
 
   virtual void render(Renderer& renderer) override {
     drawFun(renderer, getBounds());
   }
 
+  virtual bool isStatic() override {
+    return constant;
+  }
+
   virtual optional<int> getPreferredWidth() override {
     if (preferredWidth)
       return preferredWidth();
@@ -316,20 +348,22 @@ class DrawCustom : public GuiElem {
   private:
   DrawFun drawFun;
   function<int()> preferredWidth;
+  // Set if drawFun draws the same thing every time it's given the same bounds.
+  bool constant;
 };
 
 SGuiElem GuiFactory::rectangle(Color color, optional<Color> borderColor) {
   return SGuiElem(new DrawCustom(
         [=] (Renderer& r, Rectangle bounds) {
           r.drawFilledRectangle(bounds, color, borderColor);
-        }));
+        }, nullptr, true));
 }
 
 SGuiElem GuiFactory::repeatedPattern(Texture& tex) {
   return SGuiElem(new DrawCustom(
         [&tex] (Renderer& r, Rectangle bounds) {
           r.drawSprite(bounds.topLeft(), Vec2(0, 0), Vec2(bounds.width(), bounds.height()), tex);
-        }));
+        }, nullptr, true));
 }
 
 SGuiElem GuiFactory::sprite(Texture& tex, double height) {
@@ -338,80 +372,86 @@ SGuiElem GuiFactory::sprite(Texture& tex, double height) {
           Vec2 size = tex.getSize();
           r.drawSprite(bounds.topLeft(), Vec2(0, 0), size, tex,
               Vec2(height * size.x / size.y, height));
-        }));
+        }, nullptr, true));
+}
+
+static void drawSprite(Renderer& r, Rectangle bounds, Texture& tex, GuiFactory::Alignment align, bool vFlip,
+    bool hFlip, Vec2 offset, Color color) {
+  using Alignment = GuiFactory::Alignment;
+  Vec2 size = tex.getSize();
+  optional<Vec2> stretchSize;
+  Vec2 origin;
+  Vec2 pos;
+  switch (align) {
+    case Alignment::TOP:
+      pos = bounds.topLeft() + offset;
+      size = Vec2(bounds.width() - 2 * offset.x, size.y);
+      break;
+    case Alignment::BOTTOM:
+      pos = bounds.bottomLeft() + Vec2(0, -size.y) + offset;
+      size = Vec2(bounds.width() - 2 * offset.x, size.y);
+      break;
+    case Alignment::RIGHT:
+      pos = bounds.topRight() + Vec2(-size.x, 0) + offset;
+      size = Vec2(size.x, bounds.height() - 2 * offset.y);
+      break;
+    case Alignment::LEFT:
+      pos = bounds.topLeft() + offset;
+      size = Vec2(size.x, bounds.height() - 2 * offset.y);
+      break;
+    case Alignment::TOP_LEFT:
+      pos = bounds.topLeft() + offset;
+      break;
+    case Alignment::TOP_RIGHT:
+      pos = bounds.topRight() - Vec2(size.x, 0) + offset;
+      break;
+    case Alignment::BOTTOM_RIGHT:
+      pos = bounds.bottomRight() - size + offset;
+      break;
+    case Alignment::BOTTOM_LEFT:
+      pos = bounds.bottomLeft() - Vec2(0, size.y) + offset;
+      break;
+    case Alignment::CENTER:
+      pos = bounds.middle() - Vec2(size.x / 2, size.y / 2) + offset;
+      break;
+    case Alignment::TOP_CENTER:
+      pos = (bounds.topLeft() + bounds.topRight()) / 2 - Vec2(size.x / 2, 0) + offset;
+      break;
+    case Alignment::LEFT_CENTER:
+      pos = (bounds.topLeft() + bounds.bottomLeft()) / 2 - Vec2(0, size.y / 2) + offset;
+      break;
+    case Alignment::BOTTOM_CENTER:
+      pos = (bounds.bottomLeft() + bounds.bottomRight()) / 2 - Vec2(size.x / 2, size.y) + offset;
+      break;
+    case Alignment::RIGHT_CENTER:
+      pos = (bounds.topRight() + bounds.bottomRight()) / 2 - Vec2(size.x, size.y / 2) + offset;
+      break;
+    case Alignment::VERTICAL_CENTER:
+      pos = (bounds.topLeft() + bounds.topRight()) / 2 - Vec2(size.x / 2, 0) + offset;
+      size = Vec2(size.x, bounds.height() - 2 * offset.y);
+      break;
+    case Alignment::LEFT_STRETCHED:
+      stretchSize = size * (double(bounds.height()) / size.y);
+      pos = (bounds.topLeft() + bounds.bottomLeft()) / 2 - Vec2(0, stretchSize->y / 2) + offset;
+      break;
+    case Alignment::RIGHT_STRETCHED:
+      stretchSize = size * (double(bounds.height()) / size.y);
+      pos = (bounds.topRight() + bounds.bottomRight()) / 2
+          - Vec2(stretchSize->x, stretchSize->y / 2) + offset;
+      break;
+    case Alignment::CENTER_STRETCHED:
+      stretchSize = size * (double(bounds.height()) / size.y);
+      pos = (bounds.topRight() + bounds.topLeft()) / 2 - Vec2(stretchSize->x / 2, 0) + offset;
+  }
+  r.drawSprite(pos, origin, size, tex, stretchSize, color, vFlip, hFlip);
 }
 
 SGuiElem GuiFactory::sprite(Texture& tex, Alignment align, bool vFlip, bool hFlip, Vec2 offset,
     function<Color()> col) {
   return SGuiElem(new DrawCustom(
         [&tex, align, offset, col, vFlip, hFlip] (Renderer& r, Rectangle bounds) {
-          Vec2 size = tex.getSize();
-          optional<Vec2> stretchSize;
-          Vec2 origin;
-          Vec2 pos;
-          switch (align) {
-            case Alignment::TOP:
-              pos = bounds.topLeft() + offset;
-              size = Vec2(bounds.width() - 2 * offset.x, size.y);
-              break;
-            case Alignment::BOTTOM:
-              pos = bounds.bottomLeft() + Vec2(0, -size.y) + offset;
-              size = Vec2(bounds.width() - 2 * offset.x, size.y);
-              break;
-            case Alignment::RIGHT:
-              pos = bounds.topRight() + Vec2(-size.x, 0) + offset;
-              size = Vec2(size.x, bounds.height() - 2 * offset.y);
-              break;
-            case Alignment::LEFT:
-              pos = bounds.topLeft() + offset;
-              size = Vec2(size.x, bounds.height() - 2 * offset.y);
-              break;
-            case Alignment::TOP_LEFT:
-              pos = bounds.topLeft() + offset;
-              break;
-            case Alignment::TOP_RIGHT:
-              pos = bounds.topRight() - Vec2(size.x, 0) + offset;
-              break;
-            case Alignment::BOTTOM_RIGHT:
-              pos = bounds.bottomRight() - size + offset;
-              break;
-            case Alignment::BOTTOM_LEFT:
-              pos = bounds.bottomLeft() - Vec2(0, size.y) + offset;
-              break;
-            case Alignment::CENTER:
-              pos = bounds.middle() - Vec2(size.x / 2, size.y / 2) + offset;
-              break;
-            case Alignment::TOP_CENTER:
-              pos = (bounds.topLeft() + bounds.topRight()) / 2 - Vec2(size.x / 2, 0) + offset;
-              break;
-            case Alignment::LEFT_CENTER:
-              pos = (bounds.topLeft() + bounds.bottomLeft()) / 2 - Vec2(0, size.y / 2) + offset;
-              break;
-            case Alignment::BOTTOM_CENTER:
-              pos = (bounds.bottomLeft() + bounds.bottomRight()) / 2 - Vec2(size.x / 2, size.y) + offset;
-              break;
-            case Alignment::RIGHT_CENTER:
-              pos = (bounds.topRight() + bounds.bottomRight()) / 2 - Vec2(size.x, size.y / 2) + offset;
-              break;
-            case Alignment::VERTICAL_CENTER:
-              pos = (bounds.topLeft() + bounds.topRight()) / 2 - Vec2(size.x / 2, 0) + offset;
-              size = Vec2(size.x, bounds.height() - 2 * offset.y);
-              break;
-            case Alignment::LEFT_STRETCHED:
-              stretchSize = size * (double(bounds.height()) / size.y);
-              pos = (bounds.topLeft() + bounds.bottomLeft()) / 2 - Vec2(0, stretchSize->y / 2) + offset;
-              break;
-            case Alignment::RIGHT_STRETCHED:
-              stretchSize = size * (double(bounds.height()) / size.y);
-              pos = (bounds.topRight() + bounds.bottomRight()) / 2
-                  - Vec2(stretchSize->x, stretchSize->y / 2) + offset;
-              break;
-            case Alignment::CENTER_STRETCHED:
-              stretchSize = size * (double(bounds.height()) / size.y);
-              pos = (bounds.topRight() + bounds.topLeft()) / 2 - Vec2(stretchSize->x / 2, 0) + offset;
-          }
-          r.drawSprite(pos, origin, size, tex, stretchSize, !!col ? col() : colors[ColorId::WHITE], vFlip, hFlip);
-        }));
+          drawSprite(r, bounds, tex, align, vFlip, hFlip, offset, !!col ? col() : colors[ColorId::WHITE]);
+        }, nullptr, !col));
 }
 
 SGuiElem GuiFactory::label(const string& s, Color c, char hotkey) {
@@ -421,7 +461,7 @@ SGuiElem GuiFactory::label(const string& s, Color c, char hotkey) {
           r.drawTextWithHotkey(transparency(colors[ColorId::BLACK], 100),
             bounds.topLeft().x + 1, bounds.topLeft().y + 2, s, 0);
           r.drawTextWithHotkey(c, bounds.topLeft().x, bounds.topLeft().y, s, hotkey);
-        }, width));
+        }, width, true));
 }
 
 static vector<string> breakWord(Renderer& renderer, string word, int maxWidth, int size) {
@@ -569,7 +609,7 @@ SGuiElem GuiFactory::label(const string& s, int size, Color c) {
           r.drawText(transparency(colors[ColorId::BLACK], 100),
             bounds.topLeft().x + 1, bounds.topLeft().y + 2, s, Renderer::NONE, size);
           r.drawText(c, bounds.topLeft().x, bounds.topLeft().y, s, Renderer::NONE, size);
-        }, width));
+        }, width, true));
 }
 
 static Vec2 getTextPos(Rectangle bounds, Renderer::CenterType center) {
@@ -591,7 +631,7 @@ SGuiElem GuiFactory::centeredLabel(Renderer::CenterType center, const string& s,
           Vec2 pos = getTextPos(bounds, center);
           r.drawText(transparency(colors[ColorId::BLACK], 100), pos.x + 1, pos.y + 2, s, center, size);
           r.drawText(c, pos.x, pos.y, s, center, size);
-        }));
+        }, nullptr, true));
 }
 
 SGuiElem GuiFactory::centeredLabel(Renderer::CenterType center, const string& s, Color c) {
@@ -692,16 +732,37 @@ class GuiLayout : public GuiElem {
   }
 
   virtual void render(Renderer& r) override {
-    for (int i : All(elems))
-      if (isVisible(i))
-        elems[i]->render(r);
+    if (isStatic()) {
+      if (!drawList || !r.replayDrawList(drawList)) {
+        r.startDrawList();
+        renderElems(r);
+        drawList = r.finishDrawList();
+      }
+    } else
+      renderElems(r);
   }
 
   virtual void onRefreshBounds() override {
+    drawList = nullptr;
     for (int i : All(elems))
       elems[i]->setBounds(getElemBounds(i));
   }
 
+  virtual bool isStatic() override {
+    if (!staticElems) {
+      staticElems = retained;
+      for (auto& elem : elems)
+        if (!elem->isStatic())
+          staticElems = false;
+    }
+    return *staticElems;
+  }
+
+  // Only set for layouts that place and draw the elements depending on nothing but the bounds.
+  void setRetained() {
+    retained = true;
+  }
+
   virtual bool onKeyPressed2(SDL_Keysym key) override {
     for (int i : AllReverse(elems))
       if (elems[i]->onKeyPressed2(key))
@@ -725,8 +786,24 @@ class GuiLayout : public GuiElem {
 
   protected:
   vector<SGuiElem> elems;
+
+  private:
+  void renderElems(Renderer& r) {
+    for (int i : All(elems))
+      if (isVisible(i))
+        elems[i]->render(r);
+  }
+
+  bool retained = false;
+  optional<bool> staticElems;
+  shared_ptr<Renderer::DrawList> drawList;
 };
 
+static SGuiElem retain(GuiLayout* layout) {
+  layout->setRetained();
+  return SGuiElem(layout);
+}
+
 class GuiStack : public GuiLayout {
   public:
   using GuiLayout::GuiLayout;
@@ -758,7 +835,7 @@ class GuiStack : public GuiLayout {
 };
 
 SGuiElem GuiFactory::stack(vector<SGuiElem> elems) {
-  return SGuiElem(new GuiStack(std::move(elems)));
+  return retain(new GuiStack(std::move(elems)));
 }
 
 SGuiElem GuiFactory::stack(SGuiElem g1, SGuiElem g2) {
@@ -876,6 +953,10 @@ class KeyHandler : public GuiElem {
   public:
   KeyHandler(function<void(SDL_Keysym)> f, bool cap) : fun(f), capture(cap) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual bool onKeyPressed2(SDL_Keysym key) override {
     fun(key);
     return capture;
@@ -942,7 +1023,7 @@ class AlignmentGui : public GuiLayout {
 };
 
 SGuiElem GuiFactory::alignment(GuiFactory::Alignment alignment, SGuiElem content, optional<Vec2> size) {
-  return SGuiElem(new AlignmentGui(std::move(content), alignment, size));
+  return retain(new AlignmentGui(std::move(content), alignment, size));
 }
  
 SGuiElem GuiFactory::keyHandler(function<void(SDL_Keysym)> fun, bool capture) {
@@ -953,6 +1034,10 @@ class KeyHandler2 : public GuiElem {
   public:
   KeyHandler2(function<void()> f, vector<SDL_Keysym> k, bool cap) : fun(f), key(k), capture(cap) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   virtual bool onKeyPressed2(SDL_Keysym k) override {
     for (auto& elem : key)
       if (GuiFactory::keyEventEqual(k, elem)) {
@@ -977,6 +1062,10 @@ class KeyHandlerChar : public GuiElem {
   KeyHandlerChar(function<void()> f, char c, bool cap, function<bool()> rAlt) : fun(f), hotkey(c), requireAlt(rAlt),
       capture(cap) {}
 
+  virtual bool isStatic() override {
+    return true;
+  }
+
   bool isHotkeyEvent(char c, SDL_Keysym key) {
     return requireAlt() == GuiFactory::isAlt(key) &&
       !GuiFactory::isCtrl(key) &&
@@ -1115,7 +1204,7 @@ class VerticalList : public ElemList {
 
 SGuiElem GuiFactory::verticalList(vector<SGuiElem> e, int height) {
   vector<int> heights(e.size(), height);
-  return SGuiElem(new VerticalList(std::move(e), heights, 0, false));
+  return retain(new VerticalList(std::move(e), heights, 0, false));
 }
 
 class HorizontalList : public ElemList {
@@ -1142,7 +1231,7 @@ class HorizontalList : public ElemList {
 
 SGuiElem GuiFactory::horizontalList(vector<SGuiElem> e, int height) {
   vector<int> heights(e.size(), height);
-  return SGuiElem(new HorizontalList(std::move(e), heights, 0, false));
+  return retain(new HorizontalList(std::move(e), heights, 0, false));
 }
 
 GuiFactory::ListBuilder GuiFactory::getListBuilder(int defaultSize) {
@@ -1235,14 +1324,14 @@ SGuiElem GuiFactory::ListBuilder::buildVerticalList() {
   for (int i : All(sizes))
     if (sizes[i] == -1)
       sizes[i] = *elems[i]->getPreferredHeight();
-  return SGuiElem(new VerticalList(std::move(elems), sizes, backElems, middleElem));
+  return retain(new VerticalList(std::move(elems), sizes, backElems, middleElem));
 }
 
 SGuiElem GuiFactory::ListBuilder::buildHorizontalList() {
   for (int i : All(sizes))
     if (sizes[i] == -1)
       sizes[i] = *elems[i]->getPreferredWidth();
-  return SGuiElem(new HorizontalList(std::move(elems), sizes, backElems, middleElem));
+  return retain(new HorizontalList(std::move(elems), sizes, backElems, middleElem));
 }
 
 SGuiElem GuiFactory::ListBuilder::buildHorizontalListFit() {
@@ -1273,7 +1362,7 @@ class VerticalListFit : public GuiLayout {
 
 
 SGuiElem GuiFactory::verticalListFit(vector<SGuiElem> e, double spacing) {
-  return SGuiElem(new VerticalListFit(std::move(e), spacing));
+  return retain(new VerticalListFit(std::move(e), spacing));
 }
 
 class HorizontalListFit : public GuiLayout {
@@ -1294,7 +1383,7 @@ class HorizontalListFit : public GuiLayout {
 
 
 SGuiElem GuiFactory::horizontalListFit(vector<SGuiElem> e, double spacing) {
-  return SGuiElem(new HorizontalListFit(std::move(e), spacing));
+  return retain(new HorizontalListFit(std::move(e), spacing));
 }
 
 class VerticalAspect : public GuiLayout {
@@ -1313,7 +1402,7 @@ class VerticalAspect : public GuiLayout {
 };
 
 SGuiElem GuiFactory::verticalAspect(SGuiElem elem, double ratio) {
-  return SGuiElem(new VerticalAspect(std::move(elem), ratio));
+  return retain(new VerticalAspect(std::move(elem), ratio));
 }
 
 class CenterHoriz : public GuiLayout {
@@ -1341,7 +1430,7 @@ class CenterHoriz : public GuiLayout {
 SGuiElem GuiFactory::centerHoriz(SGuiElem e, optional<int> width) {
   if (width && *width == 0)
     return empty();
-  return SGuiElem(new CenterHoriz(std::move(e), width));
+  return retain(new CenterHoriz(std::move(e), width));
 }
 
 class CenterVert : public GuiLayout {
@@ -1369,7 +1458,7 @@ class CenterVert : public GuiLayout {
 SGuiElem GuiFactory::centerVert(SGuiElem e, optional<int> height) {
   if (height && *height == 0)
     return empty();
-  return SGuiElem(new CenterVert(std::move(e), height));
+  return retain(new CenterVert(std::move(e), height));
 }
 
 class MarginGui : public GuiLayout {
@@ -1409,7 +1498,7 @@ class MarginGui : public GuiLayout {
 };
 
 SGuiElem GuiFactory::margin(SGuiElem top, SGuiElem rest, int width, MarginType type) {
-  return SGuiElem(new MarginGui(std::move(top), std::move(rest), width, type));
+  return retain(new MarginGui(std::move(top), std::move(rest), width, type));
 }
 
 SGuiElem GuiFactory::marginAuto(SGuiElem top, SGuiElem rest, MarginType type) {
@@ -1420,7 +1509,7 @@ SGuiElem GuiFactory::marginAuto(SGuiElem top, SGuiElem rest, MarginType type) {
     case MarginType::TOP:
     case MarginType::BOTTOM: width = *top->getPreferredHeight(); break;
   }
-  return SGuiElem(new MarginGui(std::move(top), std::move(rest), width, type));
+  return retain(new MarginGui(std::move(top), std::move(rest), width, type));
 }
 
 class MaybeMargin : public MarginGui {
@@ -1508,7 +1597,7 @@ class MarginFit : public GuiLayout {
 };
 
 SGuiElem GuiFactory::marginFit(SGuiElem top, SGuiElem rest, double width, MarginType type) {
-  return SGuiElem(new MarginFit(std::move(top), std::move(rest), width, type));
+  return retain(new MarginFit(std::move(top), std::move(rest), width, type));
 }
 
 SGuiElem GuiFactory::progressBar(Color c, double state) {
@@ -1517,7 +1606,7 @@ SGuiElem GuiFactory::progressBar(Color c, double state) {
           if (width > 0)
             r.drawFilledRectangle(Rectangle(bounds.topLeft(),
                   Vec2(bounds.left() + width, bounds.bottom())), c);
-        }));
+        }, nullptr, true));
 }
 
 class Margins : public GuiLayout {
@@ -1552,27 +1641,27 @@ class Margins : public GuiLayout {
 };
 
 SGuiElem GuiFactory::margins(SGuiElem content, int left, int top, int right, int bottom) {
-  return SGuiElem(new Margins(std::move(content), left, top, right, bottom));
+  return retain(new Margins(std::move(content), left, top, right, bottom));
 }
 
 SGuiElem GuiFactory::margins(SGuiElem content, int all) {
-  return SGuiElem(new Margins(std::move(content), all, all, all, all));
+  return retain(new Margins(std::move(content), all, all, all, all));
 }
 
 SGuiElem GuiFactory::leftMargin(int size, SGuiElem content) {
-  return SGuiElem(new Margins(std::move(content), size, 0, 0, 0));
+  return retain(new Margins(std::move(content), size, 0, 0, 0));
 }
 
 SGuiElem GuiFactory::rightMargin(int size, SGuiElem content) {
-  return SGuiElem(new Margins(std::move(content), 0, 0, size, 0));
+  return retain(new Margins(std::move(content), 0, 0, size, 0));
 }
 
 SGuiElem GuiFactory::topMargin(int size, SGuiElem content) {
-  return SGuiElem(new Margins(std::move(content), 0, size, 0, 0));
+  return retain(new Margins(std::move(content), 0, size, 0, 0));
 }
 
 SGuiElem GuiFactory::bottomMargin(int size, SGuiElem content) {
-  return SGuiElem(new Margins(std::move(content), 0, 0, 0, size));
+  return retain(new Margins(std::move(content), 0, 0, 0, size));
 }
 
 class Invisible : public GuiStack {
@@ -1632,23 +1721,23 @@ class PreferredSize : public GuiLayout {
 }
 
 SGuiElem GuiFactory::preferredSize(int width, int height, SGuiElem elem) {
-  return SGuiElem(new PreferredSize(std::move(elem), width, height));
+  return retain(new PreferredSize(std::move(elem), width, height));
 }
 
 SGuiElem GuiFactory::preferredSize(Vec2 size, SGuiElem elem) {
-  return SGuiElem(new PreferredSize(std::move(elem), size.x, size.y));
+  return retain(new PreferredSize(std::move(elem), size.x, size.y));
 }
 
 SGuiElem GuiFactory::setHeight(int height, SGuiElem content) {
-  return SGuiElem(new PreferredSize(std::move(content), none, height));
+  return retain(new PreferredSize(std::move(content), none, height));
 }
 
 SGuiElem GuiFactory::setWidth(int width, SGuiElem content) {
-  return SGuiElem(new PreferredSize(std::move(content), width, none));
+  return retain(new PreferredSize(std::move(content), width, none));
 }
 
 SGuiElem GuiFactory::empty() {
-  return SGuiElem(new PreferredSize(SGuiElem(new GuiElem()), 1, 1));
+  return retain(new PreferredSize(SGuiElem(new DrawCustom([] (Renderer&, Rectangle) {}, nullptr, true)), 1, 1));
 }
 
 class ViewObjectGui : public GuiElem {
@@ -2554,7 +2643,10 @@ SGuiElem GuiFactory::sprite(TexId id, Alignment a, function<Color()> c) {
 }
 
 SGuiElem GuiFactory::sprite(Texture& t, Alignment a, Color c) {
-  return sprite(t, a, false, false, Vec2(0, 0), [=]{ return c; });
+  return SGuiElem(new DrawCustom(
+        [&t, a, c] (Renderer& r, Rectangle bounds) {
+          drawSprite(r, bounds, t, a, false, false, Vec2(0, 0), c);
+        }, nullptr, true));
 }
 
 SGuiElem GuiFactory::mainMenuLabelBg(const string& s, double vPadding, Color color) {
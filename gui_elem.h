@@ -37,6 +37,9 @@ class GuiElem {
   virtual bool onMouseWheel(Vec2 mousePos, bool up) { return false;}
   virtual optional<int> getPreferredWidth() { return none; }
   virtual optional<int> getPreferredHeight() { return none; }
+  // Static elements draw the same thing every frame as long as their bounds don't change, so they
+  // only need to be laid out again when the bounds change, and their drawing can be recorded and replayed.
+  virtual bool isStatic() { return false; }
 
   void setPreferredBounds(Vec2 origin);
   void setBounds(Rectangle);
@@ -46,6 +49,7 @@ class GuiElem {
 
   private:
   Rectangle bounds;
+  bool boundsSet = false;
 };
 
 class GuiFactory {
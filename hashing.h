@@ -64,6 +64,16 @@ size_t combineHash(const pair<T, U>& arg) {
 #define HASH_ALL(...)\
 size_t getHash() const {\
   return combineHash(__VA_ARGS__);\
+}\
+auto getHashedFields() const -> decltype(std::tie(__VA_ARGS__)) {\
+  return std::tie(__VA_ARGS__);\
+}
+
+// Types that use HASH_ALL are equal if the hashed fields are, which lets them be used as full keys
+// and not just through their hash.
+template <typename T>
+auto operator == (const T& a, const T& b) -> decltype(a.getHashedFields() == b.getHashedFields()) {
+  return a.getHashedFields() == b.getHashedFields();
 }
 
 #define HASH(X) X
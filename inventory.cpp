@@ -68,6 +68,53 @@ PItem Inventory::removeItem(Item* itemRef) {
   return item;
 }
 
+PItem Inventory::removeItem(Item* item, int count) {
+  if (count == item->getCount())
+    return removeItem(item);
+  PItem ret = item->splitStack(count);
+  weight -= ret->getWeight();
+  return ret;
+}
+
+Item* Inventory::splitItem(Item* item, int count) {
+  PItem part = removeItem(item, count);
+  Item* ret = part.get();
+  addItem(std::move(part));
+  return ret;
+}
+
+vector<Item*> Inventory::takeFromStacks(const vector<Item*>& items, int count) {
+  vector<Item*> ret;
+  for (Item* item : items) {
+    if (count <= 0)
+      break;
+    if (item->getCount() > count)
+      ret.push_back(splitItem(item, count));
+    else
+      ret.push_back(item);
+    count -= ret.back()->getCount();
+  }
+  return ret;
+}
+
+void Inventory::mergeStacks() {
+  vector<Item*> stacks;
+  for (Item* item : copyOf(getItems()))
+    if (item->getResourceId()) {
+      bool merged = false;
+      for (Item* stack : stacks)
+        if (stack->canStackWith(item)) {
+          PItem removed = removeItem(item);
+          weight += removed->getWeight();
+          stack->addToStack(std::move(removed));
+          merged = true;
+          break;
+        }
+      if (!merged)
+        stacks.push_back(item);
+    }
+}
+
 vector<PItem> Inventory::removeItems(vector<Item*> items) {
   vector<PItem> ret;
   for (Item* item : items)
@@ -31,9 +31,17 @@ class Inventory {
   void addItems(vector<PItem>);
   static function<bool(const Item*)> getIndexPredicate(ItemIndex);
   PItem removeItem(Item* item);
+  // Removes count items from a stack, splitting it if it's larger.
+  PItem removeItem(Item* item, int count);
+  // Splits count items off a stack into a new item kept in this inventory.
+  Item* splitItem(Item* item, int count);
+  // Returns items that add up to count, splitting the last stack if needed.
+  vector<Item*> takeFromStacks(const vector<Item*>& items, int count);
   vector<PItem> removeItems(vector<Item*> items);
   vector<PItem> removeAllItems();
   void clearIndex(ItemIndex);
+  // Merges items that can be stacked together. Pointers to the merged items become invalid.
+  void mergeStacks();
 
   const vector<Item*>& getItems() const;
   vector<Item*> getItems(function<bool (Item*)> predicate) const;
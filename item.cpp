@@ -31,17 +31,54 @@
 #include "corpse_info.h"
 #include "equipment.h"
 
+// Most items are created from a handful of distinct attribute sets, so they share a single copy of each.
+// The per-item parts are cleared and kept in the item instead. Models are also generated in a background
+// thread, hence the lock.
+static shared_ptr<const ItemAttributes> getPrototype(ItemAttributes attr) {
+  static std::mutex mutex;
+  static unordered_map<string, vector<std::weak_ptr<const ItemAttributes>>> prototypes;
+  attr.artifactName = none;
+  attr.modifiers.clear();
+  attr.uses = -1;
+  std::unique_lock<std::mutex> lock(mutex);
+  auto& candidates = prototypes[*attr.name];
+  for (int i = candidates.size() - 1; i >= 0; --i)
+    if (auto elem = candidates[i].lock()) {
+      if (*elem == attr)
+        return elem;
+    } else
+      removeIndex(candidates, i);
+  shared_ptr<const ItemAttributes> ret = make_shared<ItemAttributes>(std::move(attr));
+  candidates.push_back(ret);
+  return ret;
+}
+
 template <class Archive> 
 void Item::serialize(Archive& ar, const unsigned int version) {
   ar& SUBCLASS(UniqueEntity) & SUBCLASS(Renderable);
-  serializeAll(ar, attributes, discarded, shopkeeper, fire, classCache, canEquipCache);
+  if (version >= 2) {
+    serializeAll(ar, attributes, customName, artifactName, modifiers, uses, discarded, shopkeeper, fire, classCache,
+        canEquipCache, count);
+    if (Archive::is_loading::value)
+      attributes = getPrototype(*attributes);
+  } else {
+    HeapAllocated<ItemAttributes> attr;
+    serializeAll(ar, attr, discarded, shopkeeper, fire, classCache, canEquipCache);
+    if (version >= 1)
+      serializeAll(ar, count);
+    attributes = getPrototype(*attr);
+    artifactName = attr->artifactName;
+    modifiers = attr->modifiers;
+    uses = attr->uses;
+  }
 }
 
 SERIALIZABLE(Item);
 SERIALIZATION_CONSTRUCTOR_IMPL(Item);
 
 Item::Item(const ItemAttributes& attr) : Renderable(ViewObject(*attr.viewId, ViewLayer::ITEM, *attr.name)),
-    attributes(attr), fire(*attr.weight, attr.flamability), canEquipCache(!!attributes->equipmentSlot),
+    attributes(getPrototype(attr)), artifactName(attr.artifactName), modifiers(attr.modifiers), uses(attr.uses),
+    fire(*attr.weight, attr.flamability), canEquipCache(!!attributes->equipmentSlot),
     classCache(*attributes->itemClass) {
 }
 
@@ -138,6 +175,10 @@ void Item::tick(Position position) {
   specialTick(position);
 }
 
+bool Item::needsTick() const {
+  return fire->isBurning() || needsSpecialTick();
+}
+
 void Item::onHitSquareMessage(Position pos, int numItems) {
   if (attributes->fragile) {
     pos.globalMessage(
@@ -165,7 +206,7 @@ double Item::getApplyTime() const {
 }
 
 double Item::getWeight() const {
-  return *attributes->weight;
+  return *attributes->weight * count;
 }
 
 string Item::getDescription() const {
@@ -203,6 +244,45 @@ optional<CollectiveResourceId> Item::getResourceId() const {
   return attributes->resourceId;
 }
 
+int Item::getCount() const {
+  return count;
+}
+
+int Item::getCount(const vector<Item*>& items) {
+  int ret = 0;
+  for (Item* it : items)
+    ret += it->count;
+  return ret;
+}
+
+bool Item::canStackWith(const Item* other) const {
+  // Only plain resource items are stacked. Anything with extra state could be told apart.
+  auto isPlainResource = [] (const Item* it) {
+    return typeid(*it) == typeid(Item) && it->getResourceId() && !it->shopkeeper && !it->fire->isBurning() &&
+        !it->discarded;
+  };
+  return other != this && isPlainResource(this) && isPlainResource(other) &&
+      attributes == other->attributes && classCache == other->classCache &&
+      getBaseName() == other->getBaseName() && modifiers == other->modifiers;
+}
+
+void Item::addToStack(PItem item) {
+  CHECK(canStackWith(item.get()));
+  count += item->count;
+}
+
+PItem Item::splitStack(int num) {
+  CHECK(num > 0 && num < count) << "Can't split " << num << " off a stack of " << count;
+  PItem ret = makeOwner<Item>(*attributes);
+  ret->customName = customName;
+  ret->artifactName = artifactName;
+  ret->modifiers = modifiers;
+  ret->uses = uses;
+  ret->count = num;
+  count -= num;
+  return ret;
+}
+
 void Item::apply(Creature* c, bool noSound) {
   if (attributes->applySound && !noSound)
     c->addSound(*attributes->applySound);
@@ -214,7 +294,7 @@ void Item::applySpecial(Creature* c) {
     c->getGame()->getStatistics().add(StatId::SCROLL_READ);
   if (attributes->effect)
     Effect::applyToCreature(c, *attributes->effect, EffectStrength::NORMAL);
-  if (attributes->uses > -1 && --attributes->uses == 0) {
+  if (uses > -1 && --uses == 0) {
     discarded = true;
     if (attributes->usedUpMsg)
       c->playerMessage(getTheName() + " is used up.");
@@ -262,7 +342,11 @@ string Item::getNoSeeApplyMsg() const {
 }
 
 void Item::setName(const string& n) {
-  attributes->name = n;
+  customName = n;
+}
+
+const string& Item::getBaseName() const {
+  return customName ? *customName : *attributes->name;
 }
 
 const Creature* Item::getShopkeeper(const Creature* owner) const {
@@ -316,12 +400,12 @@ string Item::getPluralTheNameAndVerb(int count, const string& verbSingle, const
 
 string Item::getVisibleName(bool getPlural) const {
   if (!getPlural)
-    return *attributes->name;
+    return getBaseName();
   else {
     if (attributes->plural)
       return *attributes->plural;
     else
-      return *attributes->name + "s";
+      return getBaseName() + "s";
   }
 }
 
@@ -333,14 +417,14 @@ static string withSign(int a) {
 }
 
 string Item::getArtifactName() const {
-  CHECK(attributes->artifactName);
-  return *attributes->artifactName;
+  CHECK(artifactName);
+  return *artifactName;
 }
 
 string Item::getModifiers(bool shorten) const {
   string artStr;
-  if (attributes->artifactName) {
-    artStr = *attributes->artifactName;
+  if (artifactName) {
+    artStr = *artifactName;
     if (!shorten)
       artStr = " named " + artStr;
   }
@@ -361,11 +445,11 @@ string Item::getModifiers(bool shorten) const {
   }
   if (!shorten)
     for (auto mod : ENUM_ALL(ModifierType))
-      if (attributes->modifiers[mod] != 0)
+      if (modifiers[mod] != 0)
         printMod.insert(mod);
   vector<string> attrStrings;
   for (auto mod : printMod)
-    attrStrings.push_back(withSign(attributes->modifiers[mod]) +
+    attrStrings.push_back(withSign(modifiers[mod]) +
         (shorten ? "" : " " + Creature::getModifierName(mod)));
   if (!shorten)
     for (auto attr : ENUM_ALL(AttrType))
@@ -374,8 +458,8 @@ string Item::getModifiers(bool shorten) const {
   string attrString = combine(attrStrings, true);
   if (!attrString.empty())
     attrString = " (" + attrString + ")";
-  if (attributes->uses > -1 && attributes->displayUses) 
-    attrString += " (" + toString(attributes->uses) + " uses left)";
+  if (uses > -1 && attributes->displayUses) 
+    attrString += " (" + toString(uses) + " uses left)";
   return artStr + attrString;
 }
 
@@ -425,13 +509,13 @@ EquipmentSlot Item::getEquipmentSlot() const {
 }
 
 void Item::addModifier(ModifierType type, int value) {
-  attributes->modifiers[type] += value;
+  modifiers[type] += value;
 }
 
 int Item::getModifier(ModifierType type) const {
-  CHECK(abs(attributes->modifiers[type]) < 10000) << EnumInfo<ModifierType>::getString(type) << " "
-      << attributes->modifiers[type] << " " << getName();
-  return attributes->modifiers[type];
+  CHECK(abs(modifiers[type]) < 10000) << EnumInfo<ModifierType>::getString(type) << " "
+      << modifiers[type] << " " << getName();
+  return modifiers[type];
 }
 
 int Item::getAttr(AttrType type) const {
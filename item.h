@@ -21,6 +21,7 @@
 #include "renderable.h"
 #include "position.h"
 #include "owner_pointer.h"
+#include "modifier_type.h"
 
 class Level;
 class Attack;
@@ -80,6 +81,8 @@ class Item : public Renderable, public UniqueEntity<Item>, public std::enable_sh
   int getAttr(AttrType) const;
 
   void tick(Position);
+  // Whether tick() can change anything while the item lies on the ground.
+  bool needsTick() const;
   
   string getApplyMsgThirdPerson(const Creature* owner) const;
   string getApplyMsgFirstPerson(const Creature* owner) const;
@@ -113,12 +116,21 @@ class Item : public Renderable, public UniqueEntity<Item>, public std::enable_sh
   static vector<pair<string, vector<Item*>>> stackItems(vector<Item*>,
       function<string(const Item*)> addSuffix = [](const Item*) { return ""; });
 
+  // Identical resource items lying on one square are merged into a single item that stands for count of them.
+  int getCount() const;
+  static int getCount(const vector<Item*>&);
+  bool canStackWith(const Item*) const;
+  void addToStack(PItem);
+  // Takes count items off the stack and returns them as a new item.
+  PItem splitStack(int count);
+
   virtual optional<CorpseInfo> getCorpseInfo() const;
 
   SERIALIZATION_DECL(Item);
 
   protected:
   virtual void specialTick(Position) {}
+  virtual bool needsSpecialTick() const { return false; }
   void setName(const string& name);
   bool SERIAL(discarded) = false;
   virtual void applySpecial(Creature*);
@@ -127,9 +139,18 @@ class Item : public Renderable, public UniqueEntity<Item>, public std::enable_sh
   string getModifiers(bool shorten = false) const;
   string getVisibleName(bool plural) const;
   string getBlindName(bool plural) const;
-  HeapAllocated<ItemAttributes> SERIAL(attributes);
+  const string& getBaseName() const;
+  // Shared by all items created with equal attributes and never modified. The per-item state is kept below.
+  shared_ptr<const ItemAttributes> SERIAL(attributes);
+  optional<string> SERIAL(customName);
+  optional<string> SERIAL(artifactName);
+  EnumMap<ModifierType, int> SERIAL(modifiers);
+  int SERIAL(uses);
   optional<UniqueEntity<Creature>::Id> SERIAL(shopkeeper);
   HeapAllocated<Fire> SERIAL(fire);
   bool SERIAL(canEquipCache);
   ItemClass SERIAL(classCache);
+  int SERIAL(count) = 1;
 };
+
+BOOST_CLASS_VERSION(Item, 2)
@@ -53,5 +53,18 @@ void ItemAttributes::serialize(Archive& ar, const unsigned int version) {
     & SVAR(applySound);
 }
 
+bool ItemAttributes::operator == (const ItemAttributes& o) const {
+  return *viewId == *o.viewId && *name == *o.name && description == o.description && shortName == o.shortName &&
+      *weight == *o.weight && *itemClass == *o.itemClass && plural == o.plural && blindName == o.blindName &&
+      firingWeapon == o.firingWeapon && artifactName == o.artifactName && trapType == o.trapType &&
+      resourceId == o.resourceId && flamability == o.flamability && price == o.price &&
+      noArticle == o.noArticle && modifiers == o.modifiers && attrs == o.attrs && twoHanded == o.twoHanded &&
+      attackType == o.attackType && attackTime == o.attackTime && equipmentSlot == o.equipmentSlot &&
+      applyTime == o.applyTime && fragile == o.fragile && effect == o.effect && attackEffect == o.attackEffect &&
+      uses == o.uses && usedUpMsg == o.usedUpMsg && displayUses == o.displayUses &&
+      equipedEffect == o.equipedEffect && applyMsgFirstPerson == o.applyMsgFirstPerson &&
+      applyMsgThirdPerson == o.applyMsgThirdPerson && applySound == o.applySound;
+}
+
 SERIALIZABLE(ItemAttributes);
 SERIALIZATION_CONSTRUCTOR_IMPL(ItemAttributes);
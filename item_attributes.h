@@ -36,6 +36,8 @@ class ItemAttributes {
 
   SERIALIZATION_DECL(ItemAttributes);
 
+  bool operator == (const ItemAttributes&) const;
+
   MustInitialize<ViewId> SERIAL(viewId);
   MustInitialize<string> SERIAL(name);
   string SERIAL(description);
@@ -76,6 +76,10 @@ class FireScroll : public Item {
     }
   }
 
+  virtual bool needsSpecialTick() const override {
+    return set;
+  }
+
   SERIALIZE_ALL2(Item, set);
   SERIALIZATION_CONSTRUCTOR(FireScroll);
 
@@ -217,6 +221,10 @@ class Corpse : public Item {
     }
   }
 
+  virtual bool needsSpecialTick() const override {
+    return !rotten;
+  }
+
   virtual optional<CorpseInfo> getCorpseInfo() const override { 
     return corpseInfo;
   }
@@ -266,6 +274,10 @@ class Potion : public Item {
     heat = max(0., heat - 0.005);
   }
 
+  virtual bool needsSpecialTick() const override {
+    return heat > 0;
+  }
+
   SERIALIZE_ALL2(Item, heat);
   SERIALIZATION_CONSTRUCTOR(Potion);
 
@@ -11,15 +11,31 @@ SERIALIZABLE(KnownTiles);
 void KnownTiles::addTile(Position pos) {
   known.set(pos, true);
   border.erase(pos);
+  if (borderIndex)
+    borderIndex->erase(pos);
   for (Position v : pos.neighbors4())
-    if (!known.get(v))
+    if (!known.get(v)) {
       border.insert(v);
+      if (borderIndex)
+        borderIndex->insert(v);
+    }
 }
 
 const set<Position>& KnownTiles::getBorderTiles() const {
   return border;
 }
 
+void KnownTiles::getClosestBorderTiles(Position from, double relativeMargin,
+    const function<bool(Position)>& predicate, vector<Position>& result) const {
+  if (!borderIndex) {
+    borderIndex = PositionIndex();
+    for (Position pos : border)
+      borderIndex->insert(pos);
+  }
+  if (auto dist = borderIndex->getClosestDist(from, predicate))
+    borderIndex->getWithin(from, *dist + int(*dist * relativeMargin), predicate, result);
+}
+
 bool KnownTiles::isKnown(Position pos) const {
   return known.get(pos);
 };
@@ -30,5 +46,6 @@ void KnownTiles::limitToModel(const Model* m) {
     if (p.getModel() == m)
       copy.insert(p);
   border = copy;
+  borderIndex = none;
   known.limitToModel(m);
 }
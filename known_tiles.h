@@ -16,12 +16,17 @@
 
 #include "util.h"
 #include "position_map.h"
+#include "position_index.h"
 
 class KnownTiles {
   public:
   void addTile(Position);
   bool isKnown(Position) const;
   const set<Position>& getBorderTiles() const;
+  // Appends border tiles that satisfy the predicate and are at most (1 + relativeMargin) times
+  // further from 'from' than the closest such tile.
+  void getClosestBorderTiles(Position from, double relativeMargin, const function<bool(Position)>& predicate,
+      vector<Position>& result) const;
   void limitToModel(const Model*);
 
   template <class Archive> 
@@ -30,5 +35,7 @@ class KnownTiles {
   private:
   PositionMap<bool> SERIAL(known);
   set<Position> SERIAL(border);
+  // Built lazily from border, so it doesn't need to be serialized.
+  mutable optional<PositionIndex> borderIndex;
 };
 
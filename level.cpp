@@ -520,13 +520,34 @@ void Level::addTickingFurniture(Vec2 pos) {
   tickingFurniture.insert(pos);
 }
 
+bool Level::furnitureNeedsTick(Vec2 pos) const {
+  for (auto layer : ENUM_ALL(FurnitureLayer))
+    if (auto f = furniture->getBuilt(layer).getReadonly(pos))
+      if (f->needsTick())
+        return true;
+  return false;
+}
+
 void Level::tick() {
-  for (Vec2 pos : tickingSquares)
+  // Ticking can add new squares to the sets, which doesn't invalidate the iterators.
+  for (auto it = tickingSquares.begin(); it != tickingSquares.end();) {
+    Vec2 pos = *it;
     squares->getWritable(pos)->tick(Position(pos, this));
-  for (Vec2 pos : tickingFurniture)
+    if (squares->getReadonly(pos)->needsTick())
+      ++it;
+    else
+      it = tickingSquares.erase(it);
+  }
+  for (auto it = tickingFurniture.begin(); it != tickingFurniture.end();) {
+    Vec2 pos = *it;
     for (auto layer : ENUM_ALL(FurnitureLayer))
       if (auto f = furniture->getBuilt(layer).getWritable(pos))
         f->tick(Position(pos, this));
+    if (furnitureNeedsTick(pos))
+      ++it;
+    else
+      it = tickingFurniture.erase(it);
+  }
 }
 
 bool Level::inBounds(Vec2 pos) const {
@@ -586,10 +607,39 @@ bool Level::needsRenderUpdate(Vec2 pos) const {
 }
 
 void Level::setNeedsRenderUpdate(Vec2 pos, bool s) {
+  if (s && !renderUpdates[pos])
+    renderUpdateList.push_back(pos);
   renderUpdates[pos] = s;
   setNeedsMemoryUpdate(pos, s);
 }
 
+vector<Vec2> Level::popRenderUpdates() {
+  vector<Vec2> ret;
+  ret.swap(renderUpdateList);
+  return ret;
+}
+
+void Level::addMovementChange(Vec2 pos) {
+  const int maxMovementChanges = 10000;
+  if (movementChanges.size() >= maxMovementChanges) {
+    numDiscardedMovementChanges += movementChanges.size();
+    movementChanges.clear();
+  }
+  movementChanges.push_back(pos);
+}
+
+bool Level::getMovementChanges(long long since, vector<Vec2>& changes) const {
+  if (since < numDiscardedMovementChanges)
+    return false;
+  changes.insert(changes.end(), movementChanges.begin() + (since - numDiscardedMovementChanges),
+      movementChanges.end());
+  return true;
+}
+
+long long Level::getNumMovementChanges() const {
+  return numDiscardedMovementChanges + movementChanges.size();
+}
+
 bool Level::needsMemoryUpdate(Vec2 pos) const {
   return memoryUpdates[pos];
 }
@@ -109,7 +109,8 @@ class Level {
   vector<Position> getAllPositions() const;
   //@}
 
-  /** The given square's method Square::tick() will be called every turn. */
+  /** The given square's method Square::tick() will be called every turn, until there is nothing left to tick.
+      Anything that can make a sleeping square change over time has to wake it up again with this method. */
   void addTickingSquare(Vec2 pos);
   void addTickingFurniture(Vec2 pos);
 
@@ -198,6 +199,13 @@ class Level {
   bool needsMemoryUpdate(Vec2) const;
   bool needsRenderUpdate(Vec2) const;
   void setNeedsRenderUpdate(Vec2, bool);
+  // Returns the positions marked for render update since the last call.
+  vector<Vec2> popRenderUpdates();
+
+  // Squares whose passability changed, for incremental updates of distance fields.
+  // Appends the changes after the first 'since' ones, or returns false if some of them were already discarded.
+  bool getMovementChanges(long long since, vector<Vec2>& changes) const;
+  long long getNumMovementChanges() const;
 
   LevelId getUniqueId() const;
   void setFurniture(Vec2, PFurniture);
@@ -215,11 +223,16 @@ class Level {
   HeapAllocated<Table<optional<ViewObject>>> SERIAL(background);
   Table<bool> SERIAL(memoryUpdates);
   Table<bool> renderUpdates = Table<bool>(getMaxBounds(), true);
+  vector<Vec2> renderUpdateList;
+  vector<Vec2> movementChanges;
+  long long numDiscardedMovementChanges = 0;
+  void addMovementChange(Vec2);
   Table<bool> SERIAL(unavailable);
   unordered_map<StairKey, vector<Position>> SERIAL(landingSquares);
   vector<Location*> SERIAL(locations);
   set<Vec2> SERIAL(tickingSquares);
   set<Vec2> SERIAL(tickingFurniture);
+  bool furnitureNeedsTick(Vec2) const;
   void eraseCreature(Creature*, Vec2 coord);
   void placeCreature(Creature*, Vec2 pos);
   void unplaceCreature(Creature*, Vec2 pos);
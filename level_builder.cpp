@@ -45,6 +45,14 @@ void LevelBuilder::addAttrib(Vec2 pos, SquareAttrib attr) {
   attrib[transform(pos)].insert(attr);
 }
 
+bool LevelBuilder::matches(Vec2 posT, const EnumSet<SquareAttrib>& required,
+    const EnumSet<SquareAttrib>& forbidden, const EnumSet<SquareId>& types) {
+  Vec2 pos = transform(posT);
+  const auto& attribs = attrib[pos];
+  return types.contains(type[pos].getId()) && attribs.intersection(required) == required &&
+      attribs.intersection(forbidden) == EnumSet<SquareAttrib>();
+}
+
 void LevelBuilder::removeAttrib(Vec2 pos, SquareAttrib attr) {
   attrib[transform(pos)].erase(attr);
 }
@@ -169,7 +177,7 @@ void LevelBuilder::setNoDiagonalPassing() {
 
 PLevel LevelBuilder::build(Model* m, LevelMaker* maker, LevelId levelId) {
   CHECK(mapStack.empty());
-  maker->make(this, squares.getBounds());
+  maker->makeProfiled(this, squares.getBounds());
   for (Vec2 v : squares.getBounds())
     if (!items[v].empty())
       squares.getWritable(v)->dropItemsLevelGen(std::move(items[v]));
@@ -222,9 +230,8 @@ void LevelBuilder::popMap() {
 }
 
 Vec2 LevelBuilder::transform(Vec2 v) {
-  for (auto m : reverse2(mapStack)) {
-    v = m(v);
-  }
+  for (auto it = mapStack.rbegin(); it != mapStack.rend(); ++it)
+    v = (*it)(v);
   return v;
 }
 
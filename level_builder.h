@@ -86,6 +86,10 @@ class LevelBuilder {
   /** Adds attribute to given square. The attribute will remain if the square is changed.*/
   void addAttrib(Vec2 pos, SquareAttrib attr);
 
+  /** Checks if the square has all required and none of the forbidden attributes, and one of the given types.*/
+  bool matches(Vec2 pos, const EnumSet<SquareAttrib>& required, const EnumSet<SquareAttrib>& forbidden,
+      const EnumSet<SquareId>& types);
+
   void putFurniture(Vec2 pos, FurnitureFactory&);
   void putFurniture(Vec2 pos, FurnitureParams);
   void putFurniture(Vec2 pos, FurnitureType);
@@ -32,6 +32,23 @@
 #include "furniture_type.h"
 #include "furniture_factory.h"
 #include "furniture.h"
+#include "worldgen_profiler.h"
+#include <boost/core/demangle.hpp>
+
+static string getProfilerName(const LevelMaker& maker) {
+  string name = boost::core::demangle(typeid(maker).name());
+  auto namespaceEnd = name.rfind("::");
+  if (namespaceEnd != string::npos)
+    name = name.substr(namespaceEnd + 2);
+  return name;
+}
+
+void LevelMaker::makeProfiled(LevelBuilder* builder, Rectangle area) {
+  if (auto profiler = WorldgenProfiler::getCurrent())
+    profiler->measure(getProfilerName(*this), [&] { make(builder, area); });
+  else
+    make(builder, area);
+}
 
 namespace {
 
@@ -47,6 +64,8 @@ void checkGen(bool b) {
 class Predicate {
   public:
   bool apply(LevelBuilder* builder, Vec2 pos) const {
+    if (mask)
+      return builder->matches(pos, mask->required, mask->forbidden, mask->types);
     return predFun(builder, pos);
   }
 
@@ -61,14 +80,27 @@ class Predicate {
   }
 
   static Predicate attrib(SquareAttrib attr) {
-    return Predicate([=] (LevelBuilder* builder, Vec2 pos) { return builder->hasAttrib(pos, attr);});
+    return Predicate(Mask{{attr}, {}, EnumSet<SquareId>::fullSet()});
   }
 
   static Predicate negate(Predicate p) {
+    if (p.mask) {
+      auto& m = *p.mask;
+      if (m.types == EnumSet<SquareId>::fullSet()) {
+        if (m.forbidden == EnumSet<SquareAttrib>() && isSingleElement(m.required))
+          return Predicate(Mask{{}, m.required, m.types});
+        if (m.required == EnumSet<SquareAttrib>() && isSingleElement(m.forbidden))
+          return Predicate(Mask{m.forbidden, {}, m.types});
+      }
+      if (m.required == EnumSet<SquareAttrib>() && m.forbidden == EnumSet<SquareAttrib>())
+        return Predicate(Mask{{}, {}, getComplement(m.types)});
+    }
     return Predicate([=] (LevelBuilder* builder, Vec2 pos) { return !p.apply(builder, pos);});
   }
 
   static Predicate type(SquareType t) {
+    if (!hasParameter(t))
+      return Predicate(Mask{{}, {}, {t.getId()}});
     return Predicate([=] (LevelBuilder* builder, Vec2 pos) { return builder->getType(pos) == t;});
   }
 
@@ -78,23 +110,34 @@ class Predicate {
   }
 
   static Predicate type(vector<SquareType> t) {
+    if (!std::any_of(t.begin(), t.end(), hasParameter)) {
+      EnumSet<SquareId> types;
+      for (auto& elem : t)
+        types.insert(elem.getId());
+      return Predicate(Mask{{}, {}, types});
+    }
     return Predicate([=] (LevelBuilder* builder, Vec2 pos) { return contains(t, builder->getType(pos));});
   }
 
   static Predicate alwaysTrue() {
-    return Predicate([=] (LevelBuilder* builder, Vec2 pos) { return true;});
+    return Predicate(Mask{{}, {}, EnumSet<SquareId>::fullSet()});
   }
 
   static Predicate alwaysFalse() {
-    return Predicate([=] (LevelBuilder* builder, Vec2 pos) { return false;});
+    return Predicate(Mask{{}, {}, {}});
   }
 
   static Predicate andPred(Predicate p1, Predicate p2) {
+    if (p1.mask && p2.mask)
+      return Predicate(Mask{p1.mask->required.sum(p2.mask->required), p1.mask->forbidden.sum(p2.mask->forbidden),
+          p1.mask->types.intersection(p2.mask->types)});
     return Predicate([=] (LevelBuilder* builder, Vec2 pos) {
         return p1.apply(builder, pos) && p2.apply(builder, pos);});
   }
 
   static Predicate orPred(Predicate p1, Predicate p2) {
+    if (p1.mask && p2.mask && p1.mask->isTypeOnly() && p2.mask->isTypeOnly())
+      return Predicate(Mask{{}, {}, p1.mask->types.sum(p2.mask->types)});
     return Predicate([=] (LevelBuilder* builder, Vec2 pos) {
         return p1.apply(builder, pos) || p2.apply(builder, pos);});
   }
@@ -107,6 +150,42 @@ class Predicate {
   typedef function<bool(LevelBuilder*, Vec2)> PredFun;
   Predicate(PredFun fun) : predFun(fun) {}
   PredFun predFun;
+
+  // Predicates built only from attributes and square types are compiled to bitwise operations
+  // on the attribute set of the square, instead of a chain of function calls.
+  struct Mask {
+    EnumSet<SquareAttrib> required;
+    EnumSet<SquareAttrib> forbidden;
+    EnumSet<SquareId> types;
+    bool isTypeOnly() const {
+      return required == EnumSet<SquareAttrib>() && forbidden == EnumSet<SquareAttrib>();
+    }
+  };
+  Predicate(Mask m) : mask(m) {}
+  optional<Mask> mask;
+
+  // Square types with a parameter (see SquareType) can't be matched by id alone.
+  static bool hasParameter(const SquareType& t) {
+    return t.getId() == SquareId::WATER_WITH_DEPTH;
+  }
+
+  template <typename T>
+  static bool isSingleElement(const EnumSet<T>& set) {
+    int cnt = 0;
+    for (auto elem : set) {
+      (void) elem;
+      ++cnt;
+    }
+    return cnt == 1;
+  }
+
+  static EnumSet<SquareId> getComplement(const EnumSet<SquareId>& set) {
+    EnumSet<SquareId> ret;
+    for (auto id : ENUM_ALL(SquareId))
+      if (!set.contains(id))
+        ret.insert(id);
+    return ret;
+  }
 };
 
 class SquareChange {
@@ -229,9 +308,9 @@ class RoomMaker : public LevelMaker {
         wallChange.apply(builder, Vec2(p.x + k.x - 1, i));
       }
       Rectangle inside(p.x + 1, p.y + 1, p.x + k.x - 1, p.y + k.y - 1);
-      roomContents->make(builder, inside);
+      roomContents->makeProfiled(builder, inside);
       if (i < insideMakers.size())
-        insideMakers[i]->make(builder, inside);
+        insideMakers[i]->makeProfiled(builder, inside);
       else
         for (Vec2 v : inside)
           builder->addAttrib(v, SquareAttrib::EMPTY_ROOM);
@@ -279,12 +358,14 @@ class Connector : public LevelMaker {
     return diggingCost;
   }
 
-  void connect(LevelBuilder* builder, Vec2 p1, Vec2 p2, Rectangle area) {
+  vector<Vec2> connect(LevelBuilder* builder, Vec2 p1, Vec2 p2, Rectangle area) {
     ShortestPath path(area,
         [builder, this, &area](Vec2 pos) { return getValue(builder, pos, area); }, 
         [] (Vec2 v) { return v.length4(); },
         Vec2::directions4(builder->getRandom()), p1 ,p2);
+    vector<Vec2> ret;
     for (Vec2 v = p2; v != p1; v = path.getNextMove(v)) {
+      ret.push_back(v);
       if (!builder->canNavigate(v, {MovementTrait::WALK})) {
         if (auto furniture = builder->getFurniture(v, FurnitureLayer::MIDDLE)) {
           bool placeDoor = furniture->isWall() && builder->hasAttrib(v, SquareAttrib::ROOM_WALL);
@@ -311,8 +392,50 @@ class Connector : public LevelMaker {
       if (!path.isReachable(v))
         failGen();
     }
+    return ret;
   }
 
+  // Keeps track of which squares are connected by walkable paths, updated as corridors are dug.
+  class Components {
+    public:
+    Components(LevelBuilder* b, Rectangle a) : builder(b), area(a), sets(a.area()) {
+      for (Vec2 v : area)
+        if (isWalkable(v))
+          for (Vec2 dir : {Vec2(1, 0), Vec2(0, 1), Vec2(1, 1), Vec2(-1, 1)})
+            if (isWalkable(v + dir))
+              sets.join(getIndex(v), getIndex(v + dir));
+    }
+
+    void update(const vector<Vec2>& squares) {
+      for (Vec2 v : squares)
+        if (isWalkable(v))
+          for (Vec2 dir : Vec2::directions8())
+            if (isWalkable(v + dir))
+              sets.join(getIndex(v), getIndex(v + dir));
+    }
+
+    bool same(Vec2 v, Vec2 w) {
+      return sets.same(getIndex(v), getIndex(w));
+    }
+
+    int getComponent(Vec2 v) {
+      return sets.getSet(getIndex(v));
+    }
+
+    private:
+    bool isWalkable(Vec2 v) const {
+      return v.inRectangle(area) && builder->canNavigate(v, MovementTrait::WALK);
+    }
+
+    int getIndex(Vec2 v) const {
+      return (v.x - area.left()) * area.height() + v.y - area.top();
+    }
+
+    LevelBuilder* builder;
+    Rectangle area;
+    DisjointSets sets;
+  };
+
   virtual void make(LevelBuilder* builder, Rectangle area) override {
     Vec2 p1, p2;
     vector<Vec2> points = filter(area.getAllSquares(), [&] (Vec2 v) { return connectPred.apply(builder, v);});
@@ -324,28 +447,39 @@ class Connector : public LevelMaker {
       if (p1 != p2)
         connect(builder, p1, p2, area);
     }
-    auto dijkstraFun = [&] (Vec2 pos) {
-      if (builder->canNavigate(pos, MovementTrait::WALK))
-        return 1.;
-      else
-        return ShortestPath::infinity;};
-    Table<bool> connected(area, false);
-    while (1) {
-      Dijkstra dijkstra(area, p1, 10000, dijkstraFun);
-      for (Vec2 v : area)
-        if (dijkstra.isReachable(v))
-          connected[v] = true;
-      bool found = false;
-      for (Vec2 v : area)
-        if (connectPred.apply(builder, v) && !connected[v]) {
-          connect(builder, p1, v, area);
-          p1 = v;
-          found = true;
-          break;
-         }
-      if (!found)
-        break;
+    Components components(builder, area);
+    // Pick one square of each disconnected component and join them along a minimum spanning tree,
+    // built with Prim's algorithm over the distances between these squares.
+    vector<Vec2> roots {p1};
+    set<int> seenComponents {components.getComponent(p1)};
+    for (Vec2 v : area)
+      if (connectPred.apply(builder, v) && seenComponents.insert(components.getComponent(v)).second)
+        roots.push_back(v);
+    vector<int> distance(roots.size(), 1000000000);
+    vector<int> closest(roots.size(), 0);
+    vector<bool> inTree(roots.size(), false);
+    int current = 0;
+    for (int step : Range(roots.size() - 1)) {
+      inTree[current] = true;
+      int next = -1;
+      for (int i : All(roots))
+        if (!inTree[i]) {
+          int dist = (roots[i] - roots[current]).length4();
+          if (dist < distance[i]) {
+            distance[i] = dist;
+            closest[i] = current;
+          }
+          if (next == -1 || distance[i] < distance[next])
+            next = i;
+        }
+      if (!components.same(roots[closest[next]], roots[next]))
+        components.update(connect(builder, roots[closest[next]], roots[next], area));
+      current = next;
     }
+    // Catch squares that are still disconnected, e.g. when a corridor runs through a square that can't be navigated.
+    for (Vec2 v : area)
+      if (connectPred.apply(builder, v) && !components.same(p1, v))
+        components.update(connect(builder, p1, v, area));
   }
   
   private:
@@ -851,7 +985,7 @@ class Buildings : public LevelMaker {
         builder->putFurniture(doorLoc, *building.door);
       Rectangle inside(px + 1, py + 1, px + w, py + h);
       if (i < insideMakers.size()) 
-        insideMakers[i]->make(builder, inside);
+        insideMakers[i]->makeProfiled(builder, inside);
       else
         for (Vec2 v : inside)
           builder->addAttrib(v, SquareAttrib::EMPTY_ROOM);
@@ -894,7 +1028,7 @@ class BorderGuard : public LevelMaker {
       change.apply(builder, Vec2(area.left(), i));
       change.apply(builder, Vec2(area.right() - 1, i));
     }
-    insideMaker->make(builder, Rectangle(area.left() + 1, area.top() + 1, area.right() - 1, area.bottom() - 1));
+    insideMaker->makeProfiled(builder, Rectangle(area.left() + 1, area.top() + 1, area.right() - 1, area.bottom() - 1));
   }
 
   private:
@@ -914,7 +1048,7 @@ class MakerQueue : public LevelMaker {
 
   virtual void make(LevelBuilder* builder, Rectangle area) override {
     for (auto& maker : makers)
-      maker->make(builder, area);
+      maker->makeProfiled(builder, area);
   }
 
   private:
@@ -1096,7 +1230,7 @@ class RandomLocations : public LevelMaker {
     CHECK(insideMakers.size() == occupied.size());
     for (int i : All(insideMakers)) {
       builder->pushMap(makerBounds[i], maps[i]);
-      insideMakers[i]->make(builder, makerBounds[i]);
+      insideMakers[i]->makeProfiled(builder, makerBounds[i]);
       builder->popMap();
     }
     return true;
@@ -1120,7 +1254,7 @@ class Margin : public LevelMaker {
 
   virtual void make(LevelBuilder* builder, Rectangle area) override {
     CHECK(area.width() > left + right && area.height() > top + bottom);
-    inside->make(builder, Rectangle(
+    inside->makeProfiled(builder, Rectangle(
           area.left() + left,
           area.top() + top,
           area.right() - right,
@@ -1544,9 +1678,9 @@ class Division : public LevelMaker {
   void makeHorizDiv(LevelBuilder* builder, Rectangle area) {
     int hDiv = area.left() + min(area.width() - 1, max(1, (int) (hRatio * area.width())));
     if (upperLeft)
-      upperLeft->make(builder, Rectangle(area.left(), area.top(), hDiv, area.bottom()));
+      upperLeft->makeProfiled(builder, Rectangle(area.left(), area.top(), hDiv, area.bottom()));
     if (upperRight)
-      upperRight->make(builder, Rectangle(hDiv + (wall ? 1 : 0), area.top(), area.right(), area.bottom()));
+      upperRight->makeProfiled(builder, Rectangle(hDiv + (wall ? 1 : 0), area.top(), area.right(), area.bottom()));
     if (wall)
       for (int i : Range(area.top(), area.bottom()))
         wall->apply(builder, Vec2(hDiv, i));
@@ -1555,9 +1689,9 @@ class Division : public LevelMaker {
   void makeVertDiv(LevelBuilder* builder, Rectangle area) {
     int vDiv = area.top() + min(area.height() - 1, max(1, (int) (vRatio * area.height())));
     if (upperLeft)
-      upperLeft->make(builder, Rectangle(area.left(), area.top(), area.right(), vDiv));
+      upperLeft->makeProfiled(builder, Rectangle(area.left(), area.top(), area.right(), vDiv));
     if (lowerLeft)
-      lowerLeft->make(builder, Rectangle(area.left(), vDiv + (wall ? 1 : 0), area.right(), area.bottom()));
+      lowerLeft->makeProfiled(builder, Rectangle(area.left(), vDiv + (wall ? 1 : 0), area.right(), area.bottom()));
     if (wall)
       for (int i : Range(area.left(), area.right()))
         wall->apply(builder, Vec2(i, vDiv));
@@ -1568,13 +1702,13 @@ class Division : public LevelMaker {
     int hDiv = area.left() + min(area.width() - 1, max(1, (int) (hRatio * area.width())));
     int wallSpace = wall ? 1 : 0;
     if (upperLeft)
-      upperLeft->make(builder, Rectangle(area.left(), area.top(), hDiv, vDiv));
+      upperLeft->makeProfiled(builder, Rectangle(area.left(), area.top(), hDiv, vDiv));
     if (upperRight)
-      upperRight->make(builder, Rectangle(hDiv + wallSpace, area.top(), area.right(), vDiv));
+      upperRight->makeProfiled(builder, Rectangle(hDiv + wallSpace, area.top(), area.right(), vDiv));
     if (lowerLeft)
-      lowerLeft->make(builder, Rectangle(area.left(), vDiv + wallSpace, hDiv, area.bottom()));
+      lowerLeft->makeProfiled(builder, Rectangle(area.left(), vDiv + wallSpace, hDiv, area.bottom()));
     if (lowerRight)
-      lowerRight->make(builder, Rectangle(hDiv + wallSpace, vDiv + wallSpace, area.right(), area.bottom()));
+      lowerRight->makeProfiled(builder, Rectangle(hDiv + wallSpace, vDiv + wallSpace, area.right(), area.bottom()));
     if (wall) {
       for (int i : Range(area.top(), area.bottom()))
         wall->apply(builder, Vec2(hDiv, i));
@@ -1617,9 +1751,9 @@ class AreaCorners : public LevelMaker {
   virtual void make(LevelBuilder* builder, Rectangle area) override {
     vector<Rectangle> corners = builder->getRandom().permutation(getCorners(area));
     for (int i : All(corners)) {
-      maker->make(builder, corners[i]);
+      maker->makeProfiled(builder, corners[i]);
       if (i < insideMakers.size())
-        insideMakers[i]->make(builder, corners[i]);
+        insideMakers[i]->makeProfiled(builder, corners[i]);
     }
   }
 
@@ -2398,7 +2532,7 @@ class SpecificArea : public LevelMaker {
   SpecificArea(Rectangle a, LevelMaker* m) : area(a), maker(m) {}
 
   virtual void make(LevelBuilder* builder, Rectangle) override {
-    maker->make(builder, area);
+    maker->makeProfiled(builder, area);
   }
 
   private:
@@ -89,6 +89,8 @@ struct SettlementInfo {
 class LevelMaker {
   public:
   virtual void make(LevelBuilder* builder, Rectangle area) = 0;
+  // Calls make() and reports it to the WorldgenProfiler of the current thread, if there is one.
+  void makeProfiled(LevelBuilder* builder, Rectangle area);
 
   static PLevelMaker cryptLevel(RandomGen&, SettlementInfo);
   static PLevelMaker topLevel(RandomGen&, CreatureFactory forrest, vector<SettlementInfo> village, int width,
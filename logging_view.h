@@ -33,7 +33,8 @@ enum class LoggingToken {
   CHOOSE_RECRUIT,
   CHOOSE_TRADE_ITEM,
   TRAVEL_INTERRUPT,
-  GET_TEXT
+  GET_TEXT,
+  IS_TURBO_MODE
 };
 
 #include "view.h"
@@ -81,6 +82,14 @@ class LoggingView : public View {
     virtual bool isClockStopped() override {
       return logAndGet(delegate->isClockStopped(), LoggingToken::IS_CLOCK_STOPPED);
     }
+
+    virtual bool isTurboMode() override {
+      return logAndGet(delegate->isTurboMode(), LoggingToken::IS_TURBO_MODE);
+    }
+
+    virtual void stopTurboMode() override {
+      delegate->stopTurboMode();
+    }
     
     virtual UserInput getAction() override {
       return logAndGet(delegate->getAction(), LoggingToken::GET_ACTION);
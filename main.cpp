@@ -46,6 +46,7 @@
 #include "sound_library.h"
 #include "audio_device.h"
 #include "sokoban_input.h"
+#include "trace.h"
 
 #ifndef VSTUDIO
 #include "stack_printer.h"
@@ -72,10 +73,7 @@ using namespace boost::program_options;
 using namespace boost::archive;
 
 
-void renderLoop(View* view, Options* options, atomic<bool>& finished, atomic<bool>& initialized) {
-  view->initialize();
-  options->setChoices(OptionId::FULLSCREEN_RESOLUTION, Renderer::getFullscreenResolutions());
-  initialized = true;
+void renderLoop(View* view, atomic<bool>& finished) {
   Intervalometer meter(milliseconds{1000 / 60});
   while (!finished) {    
     while (!meter.getCount(view->getTimeMilliAbsolute())) {
@@ -84,39 +82,28 @@ void renderLoop(View* view, Options* options, atomic<bool>& finished, atomic<boo
   }
 }
 
-#ifdef OSX // threads have a small stack by default on OSX, and we need a larger stack here for level gen
-static thread::attributes getAttributes() {
-  thread::attributes attr;
-  attr.set_stack_size(4096 * 4000);
-  return attr;
-}
-
+// Rendering stays on the main thread, where the window was created.
 static void runGame(function<void()> game, function<void()> render, bool singleThread) {
   if (singleThread)
     game();
   else {
-    FATAL << "Unimplemented";
-  }
-}
-
-#else
-static void runGame(function<void()> game, function<void()> render, bool singleThread) {
-  if (singleThread)
-    game();
-  else {
-    thread t(render);
-    game();
+    thread t = makeThread([game] { Tracer::setThreadName("game"); game(); });
+    try {
+      render();
+    } catch (GameExitException) {
+      t.detach();
+      throw;
+    }
     t.join();
   }
 }
 
-#endif
-void initializeRendererTiles(Renderer& r, const string& path) {
-  r.loadTilesFromDir(path + "/orig16", Vec2(16, 16));
+void initializeRendererTiles(Renderer& r, const string& path, const string& cachePath) {
+  r.loadTilesFromDir(path + "/orig16", Vec2(16, 16), cachePath + "/orig16.atlas");
 //  r.loadAltTilesFromDir(path + "/orig16_scaled", Vec2(24, 24));
-  r.loadTilesFromDir(path + "/orig24", Vec2(24, 24));
+  r.loadTilesFromDir(path + "/orig24", Vec2(24, 24), cachePath + "/orig24.atlas");
 //  r.loadAltTilesFromDir(path + "/orig24_scaled", Vec2(36, 36));
-  r.loadTilesFromDir(path + "/orig30", Vec2(30, 30));
+  r.loadTilesFromDir(path + "/orig30", Vec2(30, 30), cachePath + "/orig30.atlas");
 //  r.loadAltTilesFromDir(path + "/orig30_scaled", Vec2(45, 45));
 }
 
@@ -246,18 +233,21 @@ static options_description getOptions() {
     ("help", "Print help")
     ("steam", "Run with Steam")
     ("no_minidump", "Don't write minidumps when crashed.")
-    ("single_thread", "Use a single thread for rendering and game logic")
+    ("render_thread", "Render in a separate thread from game logic")
     ("user_dir", value<string>(), "Directory for options and save files")
     ("data_dir", value<string>(), "Directory containing the game data")
     ("upload_url", value<string>(), "URL for uploading maps")
     ("override_settings", value<string>(), "Override settings")
     ("run_tests", "Run all unit tests and exit")
     ("worldgen_test", value<int>(), "Test how often world generation fails")
+    ("gen_threads", value<int>(), "Number of level generation attempts to run in parallel")
+    ("site_pool", value<int>(), "Number of campaign sites to pre-generate for each villain, 0 to disable")
     ("force_keeper", "Skip main menu and force keeper mode")
     ("stderr", "Log to stderr")
     ("free_mode", "Run in free ascii mode")
 #ifndef RELEASE
     ("quick_level", "")
+    ("trace", value<string>(), "Write a Chrome trace of the game loop to the given file")
 #endif
     ("seed", value<int>(), "Use given seed")
     ("record", value<string>(), "Record game to file")
@@ -298,7 +288,7 @@ static int keeperMain(const variables_map& vars) {
     std::cout << getOptions() << endl;
     return 0;
   }
-  bool useSingleThread = true;//vars.count("single_thread");
+  bool useSingleThread = !vars.count("render_thread");
   FatalLog.addOutput(DebugOutput::crash());
   FatalLog.addOutput(DebugOutput::toStream(std::cerr));
 #ifndef RELEASE
@@ -364,8 +354,11 @@ static int keeperMain(const variables_map& vars) {
     if (!audioError)
       soundLibrary = new SoundLibrary(&options, audioDevice, paidDataPath + "/sound");
   }
-  if (tilesPresent)
-    initializeRendererTiles(renderer, paidDataPath + "/images");
+  if (tilesPresent) {
+    string tileCachePath = userPath + "/tile_cache";
+    makeDir(tileCachePath);
+    initializeRendererTiles(renderer, paidDataPath + "/images", tileCachePath);
+  }
   renderer.setCursorPath(freeDataPath + "/images/mouse_cursor.png", freeDataPath + "/images/mouse_cursor2.png");
   unique_ptr<View> view;
   view.reset(WindowView::createDefaultView(
@@ -374,11 +367,8 @@ static int keeperMain(const variables_map& vars) {
   InfoLog.addOutput(DebugOutput::toString([&view](const string& s) { view->logMessage(s);}));
 #endif
   std::atomic<bool> gameFinished(false);
-  std::atomic<bool> viewInitialized(false);
-  if (useSingleThread) {
-    view->initialize();
-    viewInitialized = true;
-  }
+  view->initialize();
+  options.setChoices(OptionId::FULLSCREEN_RESOLUTION, Renderer::getFullscreenResolutions());
   if (audioError)
     view->presentText("Failed to initialize audio. The game will be started without sound.", *audioError);
   Tile::initialize(renderer, tilesPresent);
@@ -393,22 +383,38 @@ static int keeperMain(const variables_map& vars) {
   SokobanInput sokobanInput(freeDataPath + "/sokoban_input.txt", userPath + "/sokoban_state.txt");
   MainLoop loop(view.get(), &highscores, &fileSharing, freeDataPath, userPath, &options, &jukebox, &sokobanInput,
       gameFinished, useSingleThread, forceGame);
+  if (vars.count("gen_threads"))
+    loop.setNumGenThreads(vars["gen_threads"].as<int>());
   if (vars.count("worldgen_test")) {
     loop.modelGenTest(vars["worldgen_test"].as<int>(), Random, &options);
     return 0;
   }
+  int sitePoolSize = vars.count("site_pool") ? vars["site_pool"].as<int>() : 1;
+  if (sitePoolSize > 0) {
+    string sitePoolPath = userPath + "/site_pool";
+    makeDir(sitePoolPath);
+    loop.enableSitePool(sitePoolPath, sitePoolSize);
+  }
+#ifndef RELEASE
+  ofstream traceOutput;
+  if (vars.count("trace")) {
+    traceOutput.open(vars["trace"].as<string>());
+    Tracer::start(traceOutput);
+    Tracer::setThreadName("main");
+  }
+#endif
   auto game = [&] {
-    while (!viewInitialized) {}
     ofstream systemInfo(userPath + "/system_info.txt");
     systemInfo << "KeeperRL version " << BUILD_VERSION << " " << BUILD_DATE << std::endl;
     renderer.printSystemInfo(systemInfo);
     loop.start(tilesPresent); };
-  auto render = [&] { renderLoop(view.get(), &options, gameFinished, viewInitialized); };
+  auto render = [&] { renderLoop(view.get(), gameFinished); };
   try {
     runGame(game, render, useSingleThread);
   } catch (GameExitException ex) {
   }
   jukebox.toggle(false);
+  Tracer::stop();
   return 0;
 }
 
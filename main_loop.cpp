@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "main_loop.h"
+#include "trace.h"
 #include "view.h"
 #include "highscores.h"
 #include "music.h"
@@ -23,6 +24,7 @@
 #include "saved_game_info.h"
 #include "retired_games.h"
 #include "save_file_info.h"
+#include "site_pool.h"
 
 MainLoop::MainLoop(View* v, Highscores* h, FileSharing* fSharing, const string& freePath,
     const string& uPath, Options* o, Jukebox* j, SokobanInput* soko, std::atomic<bool>& fin, bool singleThread,
@@ -32,6 +34,9 @@ MainLoop::MainLoop(View* v, Highscores* h, FileSharing* fSharing, const string&
         sokobanInput(soko) {
 }
 
+MainLoop::~MainLoop() {
+}
+
 vector<SaveFileInfo> MainLoop::getSaveFiles(const string& path, const string& suffix) {
   vector<SaveFileInfo> ret;
   DIR* dir = opendir(path.c_str());
@@ -75,6 +80,7 @@ static string getSaveSuffix(GameSaveType t) {
 
 template <typename InputType, typename T>
 static T loadGameUsing(const string& filename) {
+  TRACE_ZONE("load game");
   T obj;
   try {
     InputType input(filename.c_str());
@@ -115,6 +121,7 @@ static string stripFilename(string s) {
 }
 
 static void saveGame(PGame& game, const string& path) {
+  TRACE_ZONE("save game");
   CompressedOutput out(path.c_str());
   string name = game->getGameDisplayName();
   SavedGameInfo savedInfo = game->getSavedGameInfo();
@@ -125,6 +132,7 @@ static void saveGame(PGame& game, const string& path) {
 }
 
 static void saveMainModel(PGame& game, const string& path) {
+  TRACE_ZONE("save main model");
   CompressedOutput out(path.c_str());
   string name = game->getGameDisplayName();
   SavedGameInfo savedInfo = game->getSavedGameInfo();
@@ -269,15 +277,19 @@ int MainLoop::getAutosaveFreq() {
 }
 
 void MainLoop::playGame(PGame&& game, bool withMusic, bool noAutoSave) {
+  stopSitePool();
   view->reset();
   game->initialize(options, highscores, view, fileSharing);
   const milliseconds stepTimeMilli {3};
   Intervalometer meter(stepTimeMilli);
+  Intervalometer turboRefreshMeter(milliseconds{250});
   double lastMusicUpdate = -1000;
   double lastAutoSave = game->getGlobalTime();
   while (1) {
     double step = 1;
-    if (!game->isTurnBased()) {
+    // In turbo mode the game runs a full turn per step without waiting for the clock.
+    bool turbo = !game->isTurnBased() && view->isTurboMode() && !view->isClockStopped();
+    if (!game->isTurnBased() && !turbo) {
       double gameTimeStep = view->getGameSpeed() / stepTimeMilli.count();
       auto timeMilli = view->getTimeMilli();
       double count = meter.getCount(timeMilli);
@@ -317,7 +329,7 @@ void MainLoop::playGame(PGame&& game, bool withMusic, bool noAutoSave) {
         saveUI(game, GameSaveType::AUTOSAVE, SplashType::AUTOSAVING);
       lastAutoSave = gameTime;
     }
-    if (useSingleThread)
+    if (useSingleThread && (!turbo || turboRefreshMeter.getCount(view->getTimeMilliAbsolute())))
       view->refreshView();
   }
 }
@@ -400,6 +412,8 @@ PGame MainLoop::prepareSingleMap(RandomGen& random) {
 void MainLoop::playGameChoice() {
   while (1) {
     playMenuMusic();
+    if (sitePool)
+      sitePool->start(sitesPerVillain);
     PGame game;
     RandomGen random;
     optional<int> choice = view->chooseFromList("", {
@@ -494,25 +508,6 @@ void MainLoop::start(bool tilesPresent) {
   }
 }
 
-#ifdef OSX // see thread comment in stdafx.h
-static thread::attributes getAttributes() {
-  thread::attributes attr;
-  attr.set_stack_size(4096 * 4000);
-  return attr;
-}
-
-static thread makeThread(function<void()> fun) {
-  return thread(getAttributes(), fun);
-}
-
-#else
-
-static thread makeThread(function<void()> fun) {
-  return thread(fun);
-}
-
-#endif
-
 void MainLoop::doWithSplash(SplashType type, const string& text, int totalProgress,
     function<void(ProgressMeter&)> fun, function<void()> cancelFun) {
   ProgressMeter meter(1.0 / totalProgress);
@@ -545,6 +540,7 @@ void MainLoop::doWithSplash(SplashType type, const string& text, function<void()
 
 PModel MainLoop::quickGame(RandomGen& random) {
   PModel model;
+  stopSitePool();
   NameGenerator::init(dataFreePath + "/names");
   doWithSplash(SplashType::BIG, "Generating map...", 166000,
       [&] (ProgressMeter& meter) {
@@ -553,10 +549,25 @@ PModel MainLoop::quickGame(RandomGen& random) {
   return model;
 }
 
+void MainLoop::setNumGenThreads(int n) {
+  numGenThreads = n;
+}
+
+void MainLoop::enableSitePool(const string& cachePath, int num) {
+  sitePool.reset(new SitePool(cachePath, saveVersion, options));
+  sitesPerVillain = num;
+}
+
+void MainLoop::stopSitePool() {
+  // The pool only generates while in the menus. This waits for at most one site.
+  if (sitePool)
+    sitePool->stop();
+}
+
 void MainLoop::modelGenTest(int numTries, RandomGen& random, Options* options) {
   NameGenerator::init(dataFreePath + "/names");
   ProgressMeter meter(1);
-  ModelBuilder(&meter, random, options, sokobanInput).measureSiteGen(numTries);
+  ModelBuilder(&meter, random, options, sokobanInput).measureSiteGen(numTries, userPath + "/worldgen_profile.json");
 }
 
 Table<PModel> MainLoop::prepareCampaignModels(Campaign& campaign, RandomGen& random) {
@@ -568,19 +579,25 @@ Table<PModel> MainLoop::prepareCampaignModels(Campaign& campaign, RandomGen& ran
         downloadGame(retired->fileInfo.filename);
     }
   optional<string> failedToLoad;
+  stopSitePool();
   NameGenerator::init(dataFreePath + "/names");
   int numSites = campaign.getNumNonEmpty();
   doWithSplash(SplashType::BIG, "Generating map...", numSites,
       [&] (ProgressMeter& meter) {
         ModelBuilder modelBuilder(nullptr, random, options, sokobanInput);
+        modelBuilder.setNumGenThreads(numGenThreads);
         for (Vec2 v : sites.getBounds()) {
           if (!sites[v].isEmpty())
             meter.addProgress();
           if (sites[v].getKeeper()) {
             models[v] = modelBuilder.campaignBaseModel("Campaign base site",
                 campaign.getType() == CampaignType::ENDLESS);
-          } else if (auto villain = sites[v].getVillain())
-            models[v] = modelBuilder.campaignSiteModel("Campaign enemy site", villain->enemyId, villain->type);
+          } else if (auto villain = sites[v].getVillain()) {
+            if (sitePool)
+              models[v] = sitePool->take(villain->enemyId, villain->type);
+            if (!models[v])
+              models[v] = modelBuilder.campaignSiteModel("Campaign enemy site", villain->enemyId, villain->type);
+          }
           else if (auto retired = sites[v].getRetired()) {
             if (PModel m = loadModelFromFile(userPath + "/" + retired->fileInfo.filename))
               models[v] = std::move(m);
@@ -598,10 +615,12 @@ Table<PModel> MainLoop::prepareCampaignModels(Campaign& campaign, RandomGen& ran
 
 PModel MainLoop::keeperSingleMap(RandomGen& random) {
   PModel model;
+  stopSitePool();
   NameGenerator::init(dataFreePath + "/names");
   doWithSplash(SplashType::BIG, "Generating map...", 300000,
       [&] (ProgressMeter& meter) {
         ModelBuilder modelBuilder(&meter, random, options, sokobanInput);
+        modelBuilder.setNumGenThreads(numGenThreads);
         model = modelBuilder.singleMapModel(NameGenerator::get(NameGeneratorId::WORLD)->getNext());
       });
   return model;
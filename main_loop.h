@@ -15,6 +15,7 @@ class RetiredGames;
 struct SaveFileInfo;
 class GameEvents;
 class SokobanInput;
+class SitePool;
 
 class MainLoop {
   public:
@@ -24,6 +25,11 @@ class MainLoop {
 
   void start(bool tilesPresent);
   void modelGenTest(int numTries, RandomGen&, Options*);
+  void setNumGenThreads(int);
+  // Pre-generates campaign sites in the background while the player is in the menus.
+  void enableSitePool(const string& cachePath, int sitesPerVillain);
+
+  ~MainLoop();
 
   static int getAutosaveFreq();
 
@@ -79,6 +85,10 @@ class MainLoop {
   std::atomic<bool>& finished;
   bool useSingleThread;
   optional<GameTypeChoice> forceGame;
+  int numGenThreads = 1;
+  unique_ptr<SitePool> sitePool;
+  int sitesPerVillain = 0;
+  void stopSitePool();
   SokobanInput* sokobanInput;
 };
 
@@ -16,6 +16,7 @@
 #include "stdafx.h"
 
 #include "map_gui.h"
+#include "trace.h"
 #include "view_object.h"
 #include "map_layout.h"
 #include "view_index.h"
@@ -28,13 +29,15 @@
 #include "creature_view.h"
 #include "options.h"
 #include "drag_and_drop.h"
+#include "game.h"
+#include "sunlight_info.h"
 
 using SDL::SDL_Keysym;
 using SDL::SDL_Keycode;
 
 MapGui::MapGui(Callbacks call, Clock* c, Options* o, GuiFactory* f) : objects(Level::getMaxBounds()), callbacks(call),
     clock(c), options(o), fogOfWar(Level::getMaxBounds(), false), extraBorderPos(Level::getMaxBounds(), {}),
-    lastSquareUpdate(Level::getMaxBounds()), connectionMap(Level::getMaxBounds()),
+    connectionMap(Level::getMaxBounds()),
     enemyPositions(Level::getMaxBounds(), false), guiFactory(f) {
   clearCenter();
 }
@@ -916,6 +919,7 @@ void MapGui::setDraggedCreature(UniqueEntity<Creature>::Id id, ViewId viewId, Ve
 }
 
 void MapGui::render(Renderer& renderer) {
+  TRACE_ZONE("MapGui::render");
   Vec2 size = layout->getSquareSize();
   auto currentTimeReal = clock->getRealMillis();
   HighlightedInfo highlightedInfo = getHighlightedInfo(renderer, size, currentTimeReal);
@@ -954,15 +958,22 @@ void MapGui::updateEnemyPositions(const vector<Vec2>& positions) {
     enemyPositions.setValue(v, true);
 }
 
-void MapGui::updateObject(Vec2 pos, CreatureView* view, milliseconds currentTime) {
+static void getViewIndex(CreatureView* view, Vec2 pos, ViewIndex& index) {
   Level* level = view->getLevel();
-  objects[pos].emplace();
-  auto& index = *objects[pos];
   view->getViewIndex(pos, index);
   level->setNeedsRenderUpdate(pos, false);
   if (index.hasObject(ViewLayer::FLOOR) || index.hasObject(ViewLayer::FLOOR_BACKGROUND))
-    index.setHighlight(HighlightType::NIGHT, 1.0 - view->getLevel()->getLight(pos));
-  lastSquareUpdate[pos] = currentTime;
+    index.setHighlight(HighlightType::NIGHT, 1.0 - level->getLight(pos));
+}
+
+void MapGui::updateObject(Vec2 pos, CreatureView* view) {
+  objects[pos].emplace();
+  getViewIndex(view, pos, *objects[pos]);
+  updateConnections(pos);
+}
+
+void MapGui::updateConnections(Vec2 pos) {
+  auto& index = *objects[pos];
   connectionMap.remove(pos);
   shadowed.erase(pos + Vec2(0, 1));
   if (index.hasObject(ViewLayer::FLOOR)) {
@@ -983,36 +994,169 @@ void MapGui::updateObject(Vec2 pos, CreatureView* view, milliseconds currentTime
       connectionMap.add(pos, *id);
 }
 
+void MapGui::updateNightHighlight(const Level* level) {
+  double sunlight = level->getGame()->getSunlightInfo().getLightAmount();
+  if (sunlight != currentSunlight) {
+    currentSunlight = sunlight;
+    for (Vec2 pos : level->getBounds())
+      if (auto& index = objects[pos])
+        if (index->hasObject(ViewLayer::FLOOR) || index->hasObject(ViewLayer::FLOOR_BACKGROUND))
+          index->setHighlight(HighlightType::NIGHT, 1.0 - level->getLight(pos));
+  }
+}
+
+// Includes the currently displayed level.
+static const int maxLevelCacheSize = 3;
+
+bool MapGui::switchLevelCache(const CreatureView* view, const Level* level, vector<Vec2>& updates) {
+  if (view == previousView && level == previousLevel)
+    return false;
+  if (previousView && previousLevel)
+    levelCache.insert(make_pair(LevelCacheKey(previousView, previousLevel->getUniqueId()),
+        LevelCache{std::move(objects), std::move(connectionMap), std::move(shadowed), {}, false, currentSunlight,
+            ++levelCacheCounter}));
+  bool fullUpdate = true;
+  auto it = levelCache.find(LevelCacheKey(view, level->getUniqueId()));
+  if (it != levelCache.end()) {
+    auto& cache = it->second;
+    objects = std::move(cache.objects);
+    connectionMap = std::move(cache.connectionMap);
+    shadowed = std::move(cache.shadowed);
+    currentSunlight = cache.sunlight;
+    fullUpdate = cache.needsFullUpdate;
+    // Positions that changed while another view of this level was displayed.
+    if (!fullUpdate)
+      updates = std::move(cache.pendingUpdates);
+    levelCache.erase(it);
+  } else {
+    objects = Table<optional<ViewIndex>>(Level::getMaxBounds());
+    connectionMap = ViewIdMap(Level::getMaxBounds());
+    shadowed.clear();
+  }
+  while (levelCache.size() >= maxLevelCacheSize) {
+    auto oldest = levelCache.begin();
+    for (auto it = levelCache.begin(); it != levelCache.end(); ++it)
+      if (it->second.lastUsed < oldest->second.lastUsed)
+        oldest = it;
+    levelCache.erase(oldest);
+  }
+  return fullUpdate;
+}
+
+void MapGui::clearLevelCache() {
+  levelCache.clear();
+  previousView = nullptr;
+  previousLevel = nullptr;
+}
+
+static MapGui::ViewInfo getViewInfo(CreatureView* view) {
+  return {view, view->getLevel(), view->getLevel()->getBounds(), view->getVisibleEnemies(), view->getPosition(),
+      view->isPlayerView(), view->getLocalTime(), view->getMovementInfo()};
+}
+
 void MapGui::updateObjects(CreatureView* view, MapLayout* mapLayout, bool smoothMovement, bool ui) {
   Level* level = view->getLevel();
-  levelBounds = view->getLevel()->getBounds();
-  updateEnemyPositions(view->getVisibleEnemies());
+  vector<Vec2> updates;
+  bool fullUpdate = switchLevelCache(view, level, updates);
+  auto newUpdates = level->popRenderUpdates();
+  for (auto& elem : levelCache)
+    if (elem.first.second == level->getUniqueId()) {
+      auto& cache = elem.second;
+      append(cache.pendingUpdates, newUpdates);
+      if (cache.pendingUpdates.size() > level->getBounds().area()) {
+        cache.pendingUpdates.clear();
+        cache.needsFullUpdate = true;
+      }
+    }
+  if (fullUpdate) {
+    for (Vec2 pos : level->getBounds())
+      updateObject(pos, view);
+    currentSunlight = level->getGame()->getSunlightInfo().getLightAmount();
+  } else {
+    append(updates, newUpdates);
+    for (Vec2 pos : updates)
+      if (pos.inRectangle(level->getBounds()))
+        updateObject(pos, view);
+    updateNightHighlight(level);
+  }
+  updateViewInfo(getViewInfo(view), mapLayout, smoothMovement, ui);
+}
+
+void MapGui::SnapshotMaker::fill(Snapshot& snapshot, CreatureView* view) {
+  Level* level = view->getLevel();
+  snapshot.info = getViewInfo(view);
+  snapshot.objects.clear();
+  snapshot.nightHighlight.clear();
+  auto updates = level->popRenderUpdates();
+  double sunlight = level->getGame()->getSunlightInfo().getLightAmount();
+  // The render thread doesn't keep the tables of previously displayed levels, so switching always sends
+  // the whole level.
+  snapshot.fullUpdate = view != lastView || level != lastLevel;
+  if (snapshot.fullUpdate) {
+    updates.clear();
+    for (Vec2 pos : level->getBounds())
+      updates.push_back(pos);
+  } else if (sunlight != lastSunlight)
+    for (Vec2 pos : level->getBounds())
+      snapshot.nightHighlight.push_back(1.0 - level->getLight(pos));
+  for (Vec2 pos : updates)
+    if (pos.inRectangle(level->getBounds())) {
+      snapshot.objects.emplace_back(pos, ViewIndex());
+      getViewIndex(view, pos, snapshot.objects.back().second);
+    }
+  lastView = view;
+  lastLevel = level;
+  lastSunlight = sunlight;
+}
+
+void MapGui::SnapshotMaker::reset() {
+  lastView = nullptr;
+  lastLevel = nullptr;
+}
+
+void MapGui::updateObjects(const Snapshot& snapshot, MapLayout* mapLayout, bool smoothMovement, bool ui) {
+  if (snapshot.fullUpdate) {
+    objects = Table<optional<ViewIndex>>(Level::getMaxBounds());
+    connectionMap = ViewIdMap(Level::getMaxBounds());
+    shadowed.clear();
+  }
+  for (auto& elem : snapshot.objects) {
+    objects[elem.first] = elem.second;
+    updateConnections(elem.first);
+  }
+  if (!snapshot.nightHighlight.empty()) {
+    int i = 0;
+    for (Vec2 pos : snapshot.info.levelBounds) {
+      if (auto& index = objects[pos])
+        if (index->hasObject(ViewLayer::FLOOR) || index->hasObject(ViewLayer::FLOOR_BACKGROUND))
+          index->setHighlight(HighlightType::NIGHT, snapshot.nightHighlight[i]);
+      ++i;
+    }
+  }
+  updateViewInfo(snapshot.info, mapLayout, smoothMovement, ui);
+}
+
+void MapGui::updateViewInfo(const ViewInfo& info, MapLayout* mapLayout, bool smoothMovement, bool ui) {
+  levelBounds = info.levelBounds;
+  updateEnemyPositions(info.enemies);
   mouseUI = ui;
   layout = mapLayout;
-  displayScrollHint = view->isPlayerView() && !lockedView;
-  auto currentTimeReal = clock->getRealMillis();
-  if (view != previousView || level != previousLevel)
-    for (Vec2 pos : level->getBounds())
-      updateObject(pos, view, currentTimeReal);
-  else
-    for (Vec2 pos : mapLayout->getAllTiles(getBounds(), Level::getMaxBounds(), getScreenPos()))
-      if (level->needsRenderUpdate(pos) || lastSquareUpdate[pos] < currentTimeReal - milliseconds{1000})
-        updateObject(pos, view, currentTimeReal);
-  previousView = view;
-  if (previousLevel != level) {
+  displayScrollHint = info.playerView && !lockedView;
+  previousView = info.view;
+  if (previousLevel != info.level) {
     screenMovement = none;
     clearCenter();
-    setCenter(view->getPosition());
-    previousLevel = level;
+    setCenter(info.position);
+    previousLevel = info.level;
     mouseOffset = {0, 0};
   }
-  if (!isCentered() || (view->isPlayerView() && lockedView)) {
-    setCenter(view->getPosition());
+  if (!isCentered() || (info.playerView && lockedView)) {
+    setCenter(info.position);
   }
-  keyScrolling = !view->isPlayerView();
-  currentTimeGame = smoothMovement ? view->getLocalTime() : 1000000000;
+  keyScrolling = !info.playerView;
+  currentTimeGame = smoothMovement ? info.localTime : 1000000000;
   if (smoothMovement) {
-    if (auto movement = view->getMovementInfo()) {
+    if (auto& movement = info.movement) {
       if (!screenMovement || screenMovement->startTimeGame != movement->prevTime) {
         screenMovement = {
           movement->from,
@@ -22,6 +22,7 @@
 #include "view_index.h"
 #include "entity_map.h"
 #include "view_object.h"
+#include "creature_view.h"
 
 class MapMemory;
 class MapLayout;
@@ -54,6 +55,39 @@ class MapGui : public GuiElem {
   virtual bool onKeyPressed2(SDL::SDL_Keysym) override;
 
   void updateObjects(CreatureView*, MapLayout*, bool smoothMovement, bool mouseUI);
+
+  struct ViewInfo {
+    const CreatureView* view;
+    const Level* level;
+    Rectangle levelBounds;
+    vector<Vec2> enemies;
+    Vec2 position;
+    bool playerView;
+    double localTime;
+    optional<CreatureView::MovementInfo> movement;
+  };
+  // Everything updateObjects reads from the CreatureView, copied on the simulation thread, so that the map
+  // can be updated on the render thread without touching the model.
+  struct Snapshot {
+    ViewInfo info;
+    // Set if objects contains all squares of the level, otherwise only the changed ones.
+    bool fullUpdate;
+    vector<pair<Vec2, ViewIndex>> objects;
+    // The night highlight of every square of the level, only filled when the sunlight changed.
+    vector<double> nightHighlight;
+  };
+  // Keeps track of what was already sent to the render thread.
+  class SnapshotMaker {
+    public:
+    void fill(Snapshot&, CreatureView*);
+    void reset();
+
+    private:
+    const CreatureView* lastView = nullptr;
+    const Level* lastLevel = nullptr;
+    double lastSunlight = -1;
+  };
+  void updateObjects(const Snapshot&, MapLayout*, bool smoothMovement, bool mouseUI);
   void setSpriteMode(bool);
   optional<Vec2> getHighlightedTile(Renderer& renderer);
   void setHint(const vector<string>&);
@@ -61,6 +95,7 @@ class MapGui : public GuiElem {
   void setCenter(double x, double y);
   void setCenter(Vec2 pos);
   void clearCenter();
+  void clearLevelCache();
   void resetScrolling();
   bool isCentered() const;
   Vec2 getScreenPos() const;
@@ -76,7 +111,11 @@ class MapGui : public GuiElem {
   void setHighlightEnemies(bool);
 
   private:
-  void updateObject(Vec2, CreatureView*, milliseconds currentTime);
+  void updateObject(Vec2, CreatureView*);
+  void updateConnections(Vec2);
+  void updateViewInfo(const ViewInfo&, MapLayout*, bool smoothMovement, bool mouseUI);
+  bool switchLevelCache(const CreatureView*, const Level*, vector<Vec2>& pendingUpdates);
+  void updateNightHighlight(const Level*);
   void drawObjectAbs(Renderer&, Vec2 pos, const ViewObject&, Vec2 size, Vec2 tilePos, milliseconds currentTimeReal,
       const EnumMap<HighlightType, double>&);
   void drawCreatureHighlights(Renderer&, const ViewObject&, Vec2 pos, Vec2 sz, milliseconds currentTimeReal);
@@ -137,7 +176,6 @@ class MapGui : public GuiElem {
   } mouseOffset, center;
   const Level* previousLevel = nullptr;
   const CreatureView* previousView = nullptr;
-  Table<optional<milliseconds>> lastSquareUpdate;
   optional<Coords> softCenter;
   Vec2 lastMousePos;
   optional<Vec2> lastMouseMove;
@@ -178,6 +216,20 @@ class MapGui : public GuiElem {
   EntityMap<Creature, int> teamHighlight;
   optional<ViewId> buttonViewId;
   set<Vec2> shadowed;
+  // objects, connectionMap and shadowed of recently displayed (view, level) pairs, other than the current one.
+  struct LevelCache {
+    Table<optional<ViewIndex>> objects;
+    ViewIdMap connectionMap;
+    set<Vec2> shadowed;
+    vector<Vec2> pendingUpdates;
+    bool needsFullUpdate;
+    double sunlight;
+    int lastUsed;
+  };
+  typedef pair<const CreatureView*, LevelId> LevelCacheKey;
+  map<LevelCacheKey, LevelCache> levelCache;
+  int levelCacheCounter = 0;
+  double currentSunlight = -1;
   bool isRenderedHighlight(const ViewIndex&, HighlightType);
   bool isRenderedHighlightLow(const ViewIndex&, HighlightType);
   optional<ViewId> getHighlightedFurniture();
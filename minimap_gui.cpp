@@ -25,16 +25,25 @@
 #include "sdl.h"
 #include "view_object.h"
 
+const static int blockSize = 16;
+
 void MinimapGui::renderMap(Renderer& renderer, Rectangle target) {
-  if (!mapBufferTex)
-    mapBufferTex.emplace(mapBuffer);
-  else
-    CHECK(!mapBufferTex->loadFromMaybe(mapBuffer));
-  renderer.drawImage(target, info.bounds, *mapBufferTex);
+  if (!currentMap)
+    return;
+  if (!currentMap->texture)
+    currentMap->texture.emplace(currentMap->buffer);
+  else {
+    Rectangle bufferBounds(currentMap->buffer->w, currentMap->buffer->h);
+    for (Vec2 block : currentMap->dirtyBlocks)
+      CHECK(!currentMap->texture->updateFromMaybe(currentMap->buffer,
+          Rectangle(block * blockSize, (block + Vec2(1, 1)) * blockSize).intersection(bufferBounds)));
+  }
+  currentMap->dirtyBlocks.clear();
+  renderer.drawImage(target, info.bounds, *currentMap->texture);
   Vec2 topLeft = target.topLeft();
   double scale = min(double(target.width()) / info.bounds.width(),
       double(target.width()) / info.bounds.height());
-  for (Vec2 v : info.roads) {
+  for (Vec2 v : currentMap->roads) {
     Vec2 rrad(1, 1);
     Vec2 pos = topLeft + (v - info.bounds.topLeft()) * scale;
     if (pos.inRectangle(target.minusMargin(rrad.x)))
@@ -66,11 +75,22 @@ void MinimapGui::render(Renderer& r) {
 }
 
 MinimapGui::MinimapGui(Renderer& r, function<void()> f) : clickFun(f), renderer(r) {
-  mapBuffer = Renderer::createSurface(Level::getMaxBounds().width(), Level::getMaxBounds().height());
+}
+
+MinimapGui::~MinimapGui() {
+  clearLevelMaps();
+}
+
+void MinimapGui::clearLevelMaps() {
+  for (auto& elem : levelMaps)
+    SDL::SDL_FreeSurface(elem.second.buffer);
+  levelMaps.clear();
+  currentMap = nullptr;
 }
 
 void MinimapGui::clear() {
-  currentLevel = nullptr;
+  snapshotMaker.reset();
+  clearLevelMaps();
   info = MinimapInfo {};
 }
 
@@ -82,35 +102,47 @@ bool MinimapGui::onLeftClick(Vec2 v) {
   return false;
 }
 
+MinimapGui::LevelMap& MinimapGui::getLevelMap(LevelId id) {
+  auto it = levelMaps.find(id);
+  if (it != levelMaps.end())
+    return it->second;
+  LevelMap& ret = levelMaps[id];
+  ret.buffer = Renderer::createSurface(Level::getMaxBounds().width(), Level::getMaxBounds().height());
+  int col = SDL_MapRGBA(ret.buffer->format, 0, 0, 0, 1);
+  SDL_FillRect(ret.buffer, nullptr, col);
+  return ret;
+}
+
 void MinimapGui::update(const Level* level, Rectangle bounds, const CreatureView* creature, bool printLocations) {
-  info.bounds = bounds;
-  info.enemies.clear();
-  info.locations.clear();
+  snapshotMaker.fill(snapshot, level, creature, printLocations);
+  update(snapshot, bounds);
+}
+
+static void addPixel(MinimapGui::Snapshot& snapshot, Position v) {
+  const ViewObject& object = v.getViewObject();
+  snapshot.pixels.push_back({v.getCoord(), Tile::getColor(object), object.hasModifier(ViewObject::Modifier::ROAD)});
+}
+
+void MinimapGui::SnapshotMaker::fill(Snapshot& snapshot, const Level* level, const CreatureView* creature,
+    bool printLocations) {
+  snapshot.level = level->getUniqueId();
+  snapshot.pixels.clear();
+  snapshot.enemies.clear();
+  snapshot.locations.clear();
   const MapMemory& memory = creature->getMemory();
-  if (currentLevel != level) {
-    int col = SDL_MapRGBA(mapBuffer->format, 0, 0, 0, 1);
-    SDL_FillRect(mapBuffer, nullptr, col);
-    info.roads.clear();
-    for (Position v : level->getAllPositions()) {
-      if (memory.getViewIndex(v)) {
-        Renderer::putPixel(mapBuffer, v.getCoord(), Tile::getColor(v.getViewObject()));
-        if (v.getViewObject().hasModifier(ViewObject::Modifier::ROAD))
-          info.roads.insert(v.getCoord());
-      }
-    }
-    currentLevel = level;
-  }
-  for (Position v : memory.getUpdated(level)) {
-    CHECK(v.getCoord().inRectangle(Vec2(mapBuffer->w, mapBuffer->h))) << v.getCoord();
-    Renderer::putPixel(mapBuffer, v.getCoord(), Tile::getColor(v.getViewObject()));
-    if (v.getViewObject().hasModifier(ViewObject::Modifier::ROAD))
-      info.roads.insert(v.getCoord());
+  // Positions remembered while the level wasn't displayed are still in MapMemory::getUpdated,
+  // so a level only needs to be sent in full the first time.
+  if (!sentLevels.count(level->getUniqueId())) {
+    for (Position v : level->getAllPositions())
+      if (memory.getViewIndex(v))
+        addPixel(snapshot, v);
+    sentLevels.insert(level->getUniqueId());
   }
+  for (Position v : memory.getUpdated(level))
+    addPixel(snapshot, v);
   memory.clearUpdated(level);
-  info.player = creature->getPosition();
-  for (Vec2 pos : creature->getVisibleEnemies())
-    if (pos.inRectangle(bounds))
-      info.enemies.push_back(pos);
+  snapshot.player = creature->getPosition();
+  snapshot.enemies = creature->getVisibleEnemies();
   if (printLocations)
     for (const Location* loc : level->getAllLocations()) {
       bool seen = false;
@@ -120,13 +152,37 @@ void MinimapGui::update(const Level* level, Rectangle bounds, const CreatureView
           break;
         }
       if (loc->isMarkedAsSurprise() && !seen)
-        info.locations.push_back({loc->getMiddle().getCoord(), ""});
+        snapshot.locations.push_back({loc->getMiddle().getCoord(), ""});
       if (loc->getName() && seen) {
-        info.locations.push_back({loc->getBottomRight().getCoord(), *loc->getName()});
+        snapshot.locations.push_back({loc->getBottomRight().getCoord(), *loc->getName()});
       }
     }
 }
 
+void MinimapGui::SnapshotMaker::reset() {
+  sentLevels.clear();
+}
+
+void MinimapGui::update(const Snapshot& snapshot, Rectangle bounds) {
+  info.bounds = bounds;
+  currentMap = &getLevelMap(snapshot.level);
+  SDL::SDL_Surface* mapBuffer = currentMap->buffer;
+  for (auto& pixel : snapshot.pixels) {
+    CHECK(pixel.pos.inRectangle(Vec2(mapBuffer->w, mapBuffer->h))) << pixel.pos;
+    Renderer::putPixel(mapBuffer, pixel.pos, pixel.color);
+    if (currentMap->texture)
+      currentMap->dirtyBlocks.insert(pixel.pos / blockSize);
+    if (pixel.road)
+      currentMap->roads.insert(pixel.pos);
+  }
+  info.player = snapshot.player;
+  info.enemies.clear();
+  for (Vec2 pos : snapshot.enemies)
+    if (pos.inRectangle(bounds))
+      info.enemies.push_back(pos);
+  info.locations = snapshot.locations;
+}
+
 static Vec2 embed(Vec2 levelSize, Vec2 screenSize) {
   double s = min(double(screenSize.x) / levelSize.x, double(screenSize.y) / levelSize.y);
   return levelSize * s;
@@ -26,8 +26,41 @@ class MinimapGui : public GuiElem {
   public:
 
   MinimapGui(Renderer&, function<void()> clickFun);
+  ~MinimapGui();
 
   void update(const Level* level, Rectangle bounds, const CreatureView* creature, bool printLocations = false);
+
+  struct LocationLabel {
+    Vec2 pos;
+    string text;
+  };
+
+  // Everything the minimap needs from the game for one frame, so it can be collected on the game thread
+  // and applied on the render thread.
+  struct Snapshot {
+    LevelId level;
+    struct Pixel {
+      Vec2 pos;
+      Color color;
+      bool road;
+    };
+    vector<Pixel> pixels;
+    Vec2 player;
+    vector<Vec2> enemies;
+    vector<LocationLabel> locations;
+  };
+
+  class SnapshotMaker {
+    public:
+    void fill(Snapshot&, const Level*, const CreatureView*, bool printLocations = false);
+    void reset();
+
+    private:
+    // Levels that were already sent in full, only their updated positions are sent later.
+    set<LevelId> sentLevels;
+  };
+
+  void update(const Snapshot&, Rectangle bounds);
   void presentMap(const CreatureView*, Rectangle bounds, Renderer&, function<void(double, double)> clickFun);
   void clear();
 
@@ -39,23 +72,29 @@ class MinimapGui : public GuiElem {
   void renderMap(Renderer&, Rectangle target);
   void putMapPixel(Vec2 pos, Color col);
 
+  struct LevelMap {
+    SDL::SDL_Surface* buffer;
+    optional<Texture> texture;
+    unordered_set<Vec2, CustomHash<Vec2>> roads;
+    // Blocks of the buffer that were changed since the last upload to the texture.
+    set<Vec2> dirtyBlocks;
+  };
+  LevelMap& getLevelMap(LevelId);
+  void clearLevelMaps();
+  map<LevelId, LevelMap> levelMaps;
+  LevelMap* currentMap = nullptr;
+
   struct MinimapInfo {
     Rectangle bounds;
-    unordered_set<Vec2, CustomHash<Vec2>> roads;
     vector<Vec2> enemies;
     Vec2 player;
-    struct Location {
-      Vec2 pos;
-      string text;
-    };
-    vector<Location> locations;
+    vector<LocationLabel> locations;
   } info;
 
   function<void()> clickFun;
 
-  SDL::SDL_Surface* mapBuffer;
-  optional<Texture> mapBufferTex;
-  const Level* currentLevel = nullptr;
+  SnapshotMaker snapshotMaker;
+  Snapshot snapshot;
   Renderer& renderer;
 };
 
@@ -10,35 +10,30 @@
 #include "territory.h"
 #include "furniture_factory.h"
 #include "furniture.h"
+#include "lasting_effect.h"
 
-static bool betterPos(Position from, Position current, Position candidate) {
-  double maxDiff = 0.3;
-  double curDist = from.dist8(current);
-  double newDist = from.dist8(candidate);
-  return Random.getDouble() <= 1.0 - (newDist - curDist) / (curDist * maxDiff);
-}
-
-static optional<Position> getRandomCloseTile(Position from, const vector<Position>& tiles,
+static optional<Position> getRandomCloseTile(const Collective* collective, const Creature* c,
     function<bool(Position)> predicate) {
-  optional<Position> ret;
-  for (Position pos : tiles)
-    if (predicate(pos) && (!ret || betterPos(from, *ret, pos)))
-      ret = pos;
-  return ret;
+  // Tiles up to 30% further than the closest one are chosen with equal probability.
+  const double maxDiff = 0.3;
+  vector<Position> tiles;
+  collective->getKnownTiles().getClosestBorderTiles(c->getPosition(), maxDiff, predicate, tiles);
+  if (tiles.empty())
+    return none;
+  return Random.choose(tiles);
 }
 
 static optional<Position> getTileToExplore(const Collective* collective, const Creature* c, MinionTask task) {
-  vector<Position> border = Random.permutation(collective->getKnownTiles().getBorderTiles());
   switch (task) {
     case MinionTask::EXPLORE_CAVES:
-      if (auto pos = getRandomCloseTile(c->getPosition(), border,
+      if (auto pos = getRandomCloseTile(collective, c,
             [&](Position p) {
                 return p.isSameLevel(collective->getLevel()) && p.isCovered() &&
                     (!c->getPosition().isSameLevel(collective->getLevel()) || c->isSameSector(p));}))
         return pos;
     case MinionTask::EXPLORE:
     case MinionTask::EXPLORE_NOCTURNAL:
-      return getRandomCloseTile(c->getPosition(), border,
+      return getRandomCloseTile(collective, c,
           [&](Position pos) { return pos.isSameLevel(collective->getLevel()) && !pos.isCovered()
               && (!c->getPosition().isSameLevel(collective->getLevel()) || c->isSameSector(pos));});
     default: FATAL << "Unrecognized explore task: " << int(task);
@@ -90,28 +85,46 @@ optional<MinionTask> MinionTasks::getTaskFor(const Creature* c, FurnitureType ty
   return none;
 }
 
-vector<Position> MinionTasks::getAllPositions(const Collective* collective, const Creature* c, MinionTask task,
+static vector<FurnitureType> getFurnitureTypes(const Collective* collective, const Creature* c, MinionTask task,
     bool onlyActive) {
-  vector<Position> ret;
+  vector<FurnitureType> ret;
   auto& info = CollectiveConfig::getTaskInfo(task);
-  for (auto furnitureType : getAllFurniture(task))
+  for (auto furnitureType : MinionTasks::getAllFurniture(task))
     if (info.furniturePredicate(c, furnitureType) && (!onlyActive || info.activePredicate(collective, furnitureType)))
-      append(ret, collective->getConstructions().getBuiltPositions(furnitureType));
+      ret.push_back(furnitureType);
   return ret;
 }
 
+vector<Position> MinionTasks::getAllPositions(const Collective* collective, const Creature* c, MinionTask task,
+    bool onlyActive) {
+  vector<Position> ret;
+  for (auto furnitureType : getFurnitureTypes(collective, c, task, onlyActive))
+    append(ret, collective->getConstructions().getBuiltPositions(furnitureType));
+  return ret;
+}
+
+static bool isFree(Position pos) {
+  if (Creature* other = pos.getCreature())
+    return !other->hasCondition(CreatureCondition::RESTRICTED_MOVEMENT);
+  return true;
+}
+
 PTask MinionTasks::generate(Collective* collective, Creature* c, MinionTask task) {
   auto& info = CollectiveConfig::getTaskInfo(task);
   switch (info.type) {
     case MinionTaskInfo::FURNITURE: {
-      vector<Position> squares = getAllPositions(collective, c, task, true);
+      // Only the furniture that ApplySquare could choose from is passed, using the same margins
+      // as Task::RANDOM_CLOSE and Task::LAZY.
+      auto& constructions = collective->getConstructions();
+      vector<Position> squares;
+      constructions.getClosestBuilt(c->getPosition(), getFurnitureTypes(collective, c, task, true), 3, isFree,
+          squares);
       if (!squares.empty())
         return Task::applySquare(collective, squares, Task::RANDOM_CLOSE, Task::APPLY);
-      else {
-        vector<Position> squares = getAllPositions(collective, c, task, false);
-        if (!squares.empty())
-          return Task::applySquare(collective, squares, Task::LAZY, Task::NONE);
-      }
+      constructions.getClosestBuilt(c->getPosition(), getFurnitureTypes(collective, c, task, false), 0, isFree,
+          squares);
+      if (!squares.empty())
+        return Task::applySquare(collective, squares, Task::LAZY, Task::NONE);
       break;
     }
     case MinionTaskInfo::EXPLORE:
@@ -16,6 +16,7 @@
 #include "stdafx.h"
 
 #include "model.h"
+#include "trace.h"
 #include "player.h"
 #include "village_control.h"
 #include "statistics.h"
@@ -96,6 +97,7 @@ void Model::checkCreatureConsistency() {
 }
 
 void Model::update(double totalTime) {
+  TRACE_ZONE("Model::update");
   if (Creature* creature = timeQueue->getNextCreature()) {
     CHECK(creature->getLevel() != nullptr) << "Creature misplaced before processing: " << creature->getName().bare() <<
         ". Any idea why this happened?";
@@ -130,6 +132,8 @@ void Model::update(double totalTime) {
 }
 
 void Model::tick(double time) {
+  TRACE_ZONE("Model::tick");
+  processDeferredEvents();
   for (Creature* c : timeQueue->getAllCreatures()) {
     c->tick();
   }
@@ -287,7 +291,10 @@ void Model::addExternalEnemies(const ExternalEnemies& e) {
 }
 
 void Model::addEvent(const GameEvent& e) {
-  for (EventListener* l : eventGenerator->getListeners())
-    l->onEvent(e);
+  eventGenerator->addEvent(e);
+}
+
+void Model::processDeferredEvents() {
+  eventGenerator->processDeferred();
 }
 
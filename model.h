@@ -90,6 +90,7 @@ class Model {
   void lockSerialization();
 
   void addEvent(const GameEvent&);
+  void processDeferredEvents();
 
   private:
 
@@ -30,6 +30,7 @@
 #include "external_enemies.h"
 #include "immigration.h"
 #include "technology.h"
+#include "worldgen_profiler.h"
 
 using namespace std::chrono;
 
@@ -193,7 +194,7 @@ PModel ModelBuilder::tryQuickModel(int width) {
 }
 
 PModel ModelBuilder::quickModel() {
-  return tryBuilding(5000, [=] { return tryQuickModel(40); });
+  return tryBuilding(5000, [=] (ModelBuilder& b) { return b.tryQuickModel(40); });
 }
 
 SettlementInfo& ModelBuilder::makeExtraLevel(Model* model, EnemyInfo& enemy) {
@@ -291,7 +292,7 @@ static string getBoardText(const string& keeperName, const string& dukeName) {
 }
 
 PModel ModelBuilder::singleMapModel(const string& worldName) {
-  return tryBuilding(10, [&] { return trySingleMapModel(worldName);});
+  return tryBuilding(10, [&] (ModelBuilder& b) { return b.trySingleMapModel(worldName);});
 }
 
 PModel ModelBuilder::trySingleMapModel(const string& worldName) {
@@ -394,15 +395,40 @@ PModel ModelBuilder::tryCampaignSiteModel(const string& siteName, EnemyId enemyI
   return tryModel(170, siteName, enemyInfo, false, *biomeId, {});
 }
 
-PModel ModelBuilder::tryBuilding(int numTries, function<PModel()> buildFun) {
-  for (int i : Range(numTries)) {
-    try {
-      if (meter)
-        meter->reset();
-      return buildFun();
-    } catch (LevelGenException) {
-      INFO << "Retrying level gen";
-    }
+void ModelBuilder::setNumGenThreads(int n) {
+  numGenThreads = max(1, n);
+}
+
+PModel ModelBuilder::tryBuilding(int numTries, function<PModel(ModelBuilder&)> buildFun) {
+  // Attempt i always runs on seed + i and the first success in seed order wins,
+  // so the model doesn't depend on how many attempts run at once.
+  int seed = random.get(1000000000);
+  for (int first = 0; first < numTries; first += numGenThreads) {
+    int numAttempts = min(numGenThreads, numTries - first);
+    vector<PModel> models(numAttempts);
+    auto attempt = [&] (int i) {
+      RandomGen attemptRandom;
+      attemptRandom.init(seed + first + i);
+      Random.init(seed + first + i);
+      // Only one attempt reports progress, otherwise the bar would jump back and forth.
+      ModelBuilder builder(i == 0 ? meter : nullptr, attemptRandom, options, sokobanInput);
+      if (builder.meter)
+        builder.meter->reset();
+      try {
+        models[i] = buildFun(builder);
+      } catch (LevelGenException) {
+        INFO << "Retrying level gen";
+      }
+    };
+    vector<thread> threads;
+    for (int i : Range(1, numAttempts))
+      threads.push_back(makeThread([&attempt, i] { attempt(i); }));
+    attempt(0);
+    for (auto& t : threads)
+      t.join();
+    for (auto& model : models)
+      if (model)
+        return std::move(model);
   }
   FATAL << "Couldn't generate a level";
   return nullptr;
@@ -410,23 +436,67 @@ PModel ModelBuilder::tryBuilding(int numTries, function<PModel()> buildFun) {
 }
 
 PModel ModelBuilder::campaignBaseModel(const string& siteName, bool externalEnemies) {
-  return tryBuilding(20, [=] { return tryCampaignBaseModel(siteName, externalEnemies); });
+  return tryBuilding(20, [=] (ModelBuilder& b) { return b.tryCampaignBaseModel(siteName, externalEnemies); });
 }
 
 PModel ModelBuilder::campaignSiteModel(const string& siteName, EnemyId enemyId, VillainType type) {
-  return tryBuilding(20, [&] { return tryCampaignSiteModel(siteName, enemyId, type); });
+  return tryBuilding(20, [&] (ModelBuilder& b) { return b.tryCampaignSiteModel(siteName, enemyId, type); });
 }
 
-void ModelBuilder::measureSiteGen(int numTries) {
+void ModelBuilder::measureSiteGen(int numTries, const string& profilePath) {
+  WorldgenProfiler profiler;
+  ofstream profileOut(profilePath);
+  profileOut << "[";
+  bool firstSite = true;
+  auto profileModelGen = [&] (const string& site, function<void()> genFun) {
+    profiler.clear();
+    {
+      WorldgenProfiler::Scope scope(profiler);
+      measureModelGen(numTries, [&] { profiler.measure("attempt", genFun); });
+    }
+    profileOut << (firstSite ? "\n" : ",\n") << "{\"site\": \"" << site << "\", \"profile\": ";
+    profiler.writeJson(profileOut);
+    profileOut << "}";
+    firstSite = false;
+  };
   std::cout << "Measuring single map" << std::endl;
-  measureModelGen(numTries, [this] { trySingleMapModel("pok"); });
+  profileModelGen("single map", [this] { trySingleMapModel("pok"); });
+  measureThreadScaling(numTries, [this] { singleMapModel("pok"); });
   //measureModelGen(numTries, [this] { tryCampaignBaseModel("pok"); });
 //  for (EnemyId id : {EnemyId::SOKOBAN})
   for (EnemyId id : ENUM_ALL(EnemyId))
     if (!!getBiome(id, random)) {
       std::cout << "Measuring " << EnumInfo<EnemyId>::getString(id) << std::endl;
-      measureModelGen(numTries, [&] { tryCampaignSiteModel("", id, VillainType::LESSER); });
+      profileModelGen(EnumInfo<EnemyId>::getString(id), [&] { tryCampaignSiteModel("", id, VillainType::LESSER); });
+      measureThreadScaling(numTries, [&] { campaignSiteModel("", id, VillainType::LESSER); });
     }
+  profileOut << "\n]\n";
+  std::cout << "Level maker profile written to " << profilePath << std::endl;
+}
+
+void ModelBuilder::measureThreadScaling(int numTries, function<void()> genFun) {
+  int maxThreads = max<int>(1, thread::hardware_concurrency());
+  int prevNumGenThreads = numGenThreads;
+  for (int numThreads = 1; ; numThreads = min(maxThreads, numThreads * 2)) {
+    setNumGenThreads(numThreads);
+    int maxT = 0;
+    double sumT = 0;
+    for (int i : Range(numTries)) {
+#ifndef OSX
+      auto time = steady_clock::now();
+#endif
+      genFun();
+#ifndef OSX
+      int millis = duration_cast<milliseconds>(steady_clock::now() - time).count();
+      sumT += millis;
+      maxT = max(maxT, millis);
+#endif
+    }
+    std::cout << "Threads: " << numThreads << " AvgT: " << sumT / numTries << " MaxT: " << maxT << std::endl;
+    if (numThreads == maxThreads)
+      break;
+  }
+  setNumGenThreads(prevNumGenThreads);
 }
 
 void ModelBuilder::measureModelGen(int numTries, function<void()> genFun) {
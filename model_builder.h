@@ -22,7 +22,12 @@ class ModelBuilder {
   PModel campaignSiteModel(const string& siteName, EnemyId, VillainType);
 
   void measureModelGen(int numTries, function<void()> genFun);
-  void measureSiteGen(int numTries);
+  // Also writes a per-LevelMaker profile of time and failures to profilePath, as JSON.
+  void measureSiteGen(int numTries, const string& profilePath);
+  void measureThreadScaling(int numTries, function<void()> genFun);
+
+  // Number of generation attempts run at once. The chosen model doesn't depend on this value.
+  void setNumGenThreads(int);
 
   PModel quickModel();
 
@@ -44,11 +49,12 @@ class ModelBuilder {
       bool keeperSpawn, BiomeId, vector<ExternalEnemy>);
   PModel tryQuickModel(int width);
   SettlementInfo& makeExtraLevel(Model*, EnemyInfo&);
-  PModel tryBuilding(int numTries, function<PModel()> buildFun);
+  PModel tryBuilding(int numTries, function<PModel(ModelBuilder&)> buildFun);
   void addMapVillains(vector<EnemyInfo>&, BiomeId);
   RandomGen& random;
   ProgressMeter* meter;
   Options* options;
   HeapAllocated<EnemyFactory> enemyFactory;
   SokobanInput* sokobanInput;
+  int numGenThreads = 1;
 };
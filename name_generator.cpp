@@ -77,7 +77,11 @@ void NameGenerator::init(const string& namesPath) {
 }
 
 
+// Models can be generated on several threads at once.
+static std::mutex nameMutex;
+
 string NameGenerator::getNext() {
+  std::unique_lock<std::mutex> lock(nameMutex);
   CHECK(!names.empty());
   string ret = names.front();
   if (!oneName) {
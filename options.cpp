@@ -30,6 +30,8 @@ const EnumMap<OptionId, Options::Value> defaults {
   {OptionId::ZOOM_UI, 0},
   {OptionId::DISABLE_MOUSE_WHEEL, 0},
   {OptionId::DISABLE_CURSOR, 0},
+  {OptionId::TURBO_STOP_ON_ATTACK, 1},
+  {OptionId::TURBO_STOP_ON_IMMIGRANTS, 1},
   {OptionId::ONLINE, 1},
   {OptionId::GAME_EVENTS, 1},
   {OptionId::AUTOSAVE, 1},
@@ -59,6 +61,8 @@ const map<OptionId, string> names {
   {OptionId::ZOOM_UI, "Zoom in UI"},
   {OptionId::DISABLE_MOUSE_WHEEL, "Disable mouse wheel scrolling"},
   {OptionId::DISABLE_CURSOR, "Disable pretty mouse cursor"},
+  {OptionId::TURBO_STOP_ON_ATTACK, "Stop turbo speed on attacks"},
+  {OptionId::TURBO_STOP_ON_IMMIGRANTS, "Stop turbo speed on new immigrants"},
   {OptionId::ONLINE, "Online features"},
   {OptionId::GAME_EVENTS, "Anonymous statistics"},
   {OptionId::AUTOSAVE, "Autosave"},
@@ -90,6 +94,9 @@ const map<OptionId, string> hints {
     "The save file will be used to recover in case of a crash."},
   {OptionId::WASD_SCROLLING, "Scroll the map using W-A-S-D keys. In this mode building shortcuts are accessed "
     "using alt + letter."},
+  {OptionId::TURBO_STOP_ON_ATTACK, "Switch from turbo to the fastest regular speed when your dungeon is attacked."},
+  {OptionId::TURBO_STOP_ON_IMMIGRANTS, "Switch from turbo to the fastest regular speed when new immigrants "
+    "are available."},
 };
 
 const map<OptionSet, vector<OptionId>> optionSets {
@@ -105,6 +112,8 @@ const map<OptionSet, vector<OptionId>> optionSets {
       OptionId::ZOOM_UI,
       OptionId::DISABLE_MOUSE_WHEEL,
       OptionId::DISABLE_CURSOR,
+      OptionId::TURBO_STOP_ON_ATTACK,
+      OptionId::TURBO_STOP_ON_IMMIGRANTS,
       OptionId::ONLINE,
       OptionId::GAME_EVENTS,
       OptionId::AUTOSAVE,
@@ -248,6 +257,8 @@ string Options::getValueString(OptionId id) {
     case OptionId::ZOOM_UI:
     case OptionId::DISABLE_MOUSE_WHEEL:
     case OptionId::DISABLE_CURSOR:
+    case OptionId::TURBO_STOP_ON_ATTACK:
+    case OptionId::TURBO_STOP_ON_IMMIGRANTS:
     case OptionId::START_WITH_NIGHT: return getYesNo(value);
     case OptionId::ADVENTURER_NAME:
     case OptionId::KEEPER_SEED:
@@ -32,6 +32,8 @@ RICH_ENUM(OptionId,
   ZOOM_UI,
   DISABLE_MOUSE_WHEEL,
   DISABLE_CURSOR,
+  TURBO_STOP_ON_ATTACK,
+  TURBO_STOP_ON_IMMIGRANTS,
 
   FAST_IMMIGRATION,
   ADVENTURER_NAME,
@@ -68,6 +68,19 @@ Player::Player(Creature* c, Model* m, bool adv, MapMemory* memory) :
 Player::~Player() {
 }
 
+EnumSet<EventId> Player::getSubscribedEvents() const {
+  return {EventId::MOVED, EventId::ITEMS_THROWN, EventId::EXPLOSION, EventId::ALARM, EventId::CONQUERED_ENEMY,
+      EventId::WON_GAME};
+}
+
+EnumSet<EventId> Player::getDeferredEvents() const {
+  return {};
+}
+
+bool Player::isInAreaOfInterest(EventId, Position pos) const {
+  return pos.isSameLevel(getCreature()->getPosition());
+}
+
 void Player::onEvent(const GameEvent& event) {
   switch (event.getId()) {
     case EventId::MOVED: 
@@ -147,11 +160,11 @@ void Player::getItemNames(vector<Item*> items, vector<ListElem>& names, vector<v
   map<string, vector<Item*> > ret = groupBy<Item*, string>(items,
       [this] (Item* const& item) { return getInventoryItemName(item, false); });
   for (auto elem : ret) {
-    if (elem.second.size() == 1)
+    if (Item::getCount(elem.second) == 1)
       names.push_back(ListElem(getInventoryItemName(elem.second[0], false),
           predicate(elem.second[0]) ? ListElem::NORMAL : ListElem::INACTIVE).setTip(elem.second[0]->getDescription()));
     else
-      names.push_back(ListElem(toString<int>(elem.second.size()) + " "
+      names.push_back(ListElem(toString<int>(Item::getCount(elem.second)) + " "
             + getInventoryItemName(elem.second[0], true),
           predicate(elem.second[0]) ? ListElem::NORMAL : ListElem::INACTIVE).setTip(elem.second[0]->getDescription()));
     groups.push_back(elem.second);
@@ -169,11 +182,12 @@ void Player::pickUpItemAction(int numStack, bool multi) {
   }
   if (numStack < stacks.size()) {
     vector<Item*> items = stacks[numStack];
-    if (multi && items.size() > 1) {
-      auto num = getView()->getNumber("Pick up how many " + items[0]->getName(true) + "?", 1, items.size());
+    if (multi && Item::getCount(items) > 1) {
+      auto num = getView()->getNumber("Pick up how many " + items[0]->getName(true) + "?", 1,
+          Item::getCount(items));
       if (!num)
         return;
-      items = getPrefix(items, *num);
+      items = getCreature()->getPosition().modInventory().takeFromStacks(items, *num);
     }
     tryToPerform(getCreature()->pickUp(items));
   }
@@ -289,7 +303,7 @@ vector<ItemAction> Player::getItemActions(const vector<Item*>& item) const {
         }
     actions.push_back(ItemAction::THROW);
     actions.push_back(ItemAction::DROP);
-    if (item.size() > 1)
+    if (Item::getCount(item) > 1)
       actions.push_back(ItemAction::DROP_MULTI);
   }
   return actions;
@@ -300,13 +314,14 @@ void Player::handleItems(const EntitySet<Item>& itemIds, ItemAction action) {
       [&](const Item* it) { return itemIds.contains(it);});
   //CHECK(items.size() == itemIds.size()) << int(items.size()) << " " << int(itemIds.size());
   // the above assertion fails for unknown reason, so just fail this softly.
-  if (items.empty() || (items.size() == 1 && action == ItemAction::DROP_MULTI)) 
+  if (items.empty() || (Item::getCount(items) == 1 && action == ItemAction::DROP_MULTI)) 
     return;
   switch (action) {
     case ItemAction::DROP: tryToPerform(getCreature()->drop(items)); break;
     case ItemAction::DROP_MULTI:
-      if (auto num = getView()->getNumber("Drop how many " + items[0]->getName(true) + "?", 1, items.size()))
-        tryToPerform(getCreature()->drop(getPrefix(items, *num))); break;
+      if (auto num = getView()->getNumber("Drop how many " + items[0]->getName(true) + "?", 1,
+          Item::getCount(items)))
+        tryToPerform(getCreature()->drop(getCreature()->getEquipment().takeFromStacks(items, *num))); break;
     case ItemAction::THROW: throwItem(items); break;
     case ItemAction::APPLY: applyItem(items); break;
     case ItemAction::UNEQUIP: tryToPerform(getCreature()->unequip(items[0])); break;
@@ -385,7 +400,7 @@ void Player::payDebtAction() {
     if (Creature* c = pos.getCreature()) {
       if (int debt = c->getDebt(getCreature())) {
         vector<Item*> gold = getCreature()->getGold(debt);
-        if (gold.size() < debt) {
+        if (Item::getCount(gold) < debt) {
           privateMessage("You don't have enough gold to pay.");
         } else if (getView()->yesOrNoPrompt("Buy items for " + toString(debt) + " gold?")) {
           if (tryToPerform(getCreature()->give(c, gold)))
@@ -398,9 +413,10 @@ void Player::payDebtAction() {
 }
 
 void Player::giveAction(vector<Item*> items) {
-  if (items.size() > 1) {
-    if (auto num = getView()->getNumber("Give how many " + items[0]->getName(true) + "?", 1, items.size()))
-      items = getPrefix(items, *num);
+  if (Item::getCount(items) > 1) {
+    if (auto num = getView()->getNumber("Give how many " + items[0]->getName(true) + "?", 1,
+        Item::getCount(items)))
+      items = getCreature()->getEquipment().takeFromStacks(items, *num);
     else
       return;
   }
@@ -936,7 +952,7 @@ ItemInfo Player::getItemInfo(const vector<Item*>& stack) const {
     c.name = stack[0]->getShortName(getCreature());
     c.fullName = stack[0]->getNameAndModifiers(false, getCreature());
     c.description = getCreature()->isBlind() ? "" : stack[0]->getDescription();
-    c.number = stack.size();
+    c.number = Item::getCount(stack);
     c.viewId = stack[0]->getViewObject().id();
     for (auto it : stack)
       c.ids.insert(it->getUniqueId());
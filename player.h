@@ -92,6 +92,9 @@ class Player : public Controller, public CreatureView {
   HeapAllocated<EventProxy<Player>> SERIAL(eventProxy);
   friend EventProxy<Player>;
   void onEvent(const GameEvent&);
+  EnumSet<EventId> getSubscribedEvents() const;
+  EnumSet<EventId> getDeferredEvents() const;
+  bool isInAreaOfInterest(EventId, Position) const;
 
   void considerAdventurerMusic();
   void extendedAttackAction(UniqueEntity<Creature>::Id);
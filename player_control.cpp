@@ -409,6 +409,7 @@ void PlayerControl::render(View* view) {
     firstRender = false;
     initialize();
   }
+  updateVisibility();
   if (!getControlled()) {
     ViewObject::setHallu(false);
     view->updateView(this, false);
@@ -516,7 +517,7 @@ static ItemInfo getItemInfo(const vector<Item*>& stack, bool equiped, bool pendi
     c.name = stack[0]->getShortName();
     c.fullName = stack[0]->getNameAndModifiers(false);
     c.description = stack[0]->getDescription();
-    c.number = stack.size();
+    c.number = Item::getCount(stack);
     if (stack[0]->canEquip())
       c.slot = stack[0]->getEquipmentSlot();
     c.viewId = stack[0]->getViewObject().id();
@@ -562,7 +563,7 @@ static ItemInfo getTradeItemInfo(const vector<Item*>& stack, int budget) {
     c.price = make_pair(ViewId::GOLD, stack[0]->getPrice());
     c.fullName = stack[0]->getNameAndModifiers(false);
     c.description = stack[0]->getDescription();
-    c.number = stack.size();
+    c.number = Item::getCount(stack);
     c.viewId = stack[0]->getViewObject().id();
     for (auto it : stack)
       c.ids.insert(it->getUniqueId());
@@ -989,7 +990,7 @@ static ItemInfo getPillageItemInfo(const vector<Item*>& stack, bool noStorage) {
     c.name = stack[0]->getShortName(nullptr, true);
     c.fullName = stack[0]->getNameAndModifiers(false);
     c.description = stack[0]->getDescription();
-    c.number = stack.size();
+    c.number = Item::getCount(stack);
     c.viewId = stack[0]->getViewObject().id();
     for (auto it : stack)
       c.ids.insert(it->getUniqueId());
@@ -1178,6 +1179,7 @@ void PlayerControl::fillWorkshopInfo(CollectiveInfo& info) const {
     }
     ++i;
   }
+  info.chosenWorkshop.reset();
   if (chosenWorkshop) {
     auto transFun = [this](const WorkshopItem& item) { return getWorkshopItem(item); };
     info.chosenWorkshop = CollectiveInfo::ChosenWorkshopInfo {
@@ -1228,6 +1230,9 @@ void PlayerControl::fillImmigration(CollectiveInfo& info) const {
         return (i1.timeLeft && (!i2.timeLeft || *i1.timeLeft > *i2.timeLeft)) ||
             (!i1.timeLeft && !i2.timeLeft && i1.id < i2.id);
       });
+}
+
+void PlayerControl::fillImmigrationHelp(CollectiveInfo& info) const {
   info.allImmigration.clear();
   struct CreatureStats {
     Range level;
@@ -1311,36 +1316,30 @@ void PlayerControl::fillImmigration(CollectiveInfo& info) const {
   }
 }
 
-void PlayerControl::refreshGameInfo(GameInfo& gameInfo) const {
-  gameInfo.singleModel = getGame()->isSingleModel();
-  gameInfo.villageInfo.villages.clear();
-  gameInfo.villageInfo.totalMain = 0;
-  gameInfo.villageInfo.numConquered = 0;
+void PlayerControl::fillVillages(VillageInfo& info) const {
+  info.villages.clear();
+  info.totalMain = 0;
+  info.numConquered = 0;
   for (const Collective* col : getGame()->getVillains(VillainType::MAIN)) {
-    ++gameInfo.villageInfo.totalMain;
+    ++info.totalMain;
     if (col->isConquered())
-      ++gameInfo.villageInfo.numConquered;
+      ++info.numConquered;
   }
-  gameInfo.villageInfo.numMainVillains = 0;
+  info.numMainVillains = 0;
   for (const Collective* col : getKnownVillains(VillainType::MAIN)) {
-    gameInfo.villageInfo.villages.push_back(getVillageInfo(col));
-    ++gameInfo.villageInfo.numMainVillains;
+    info.villages.push_back(getVillageInfo(col));
+    ++info.numMainVillains;
   }
-  gameInfo.villageInfo.numLesserVillains = 0;
+  info.numLesserVillains = 0;
   for (const Collective* col : getKnownVillains(VillainType::LESSER)) {
-    gameInfo.villageInfo.villages.push_back(getVillageInfo(col));
-    ++gameInfo.villageInfo.numLesserVillains;
+    info.villages.push_back(getVillageInfo(col));
+    ++info.numLesserVillains;
   }
   for (const Collective* col : getKnownVillains(VillainType::ALLY))
-    gameInfo.villageInfo.villages.push_back(getVillageInfo(col));
-  SunlightInfo sunlightInfo = getGame()->getSunlightInfo();
-  gameInfo.sunlightInfo = { sunlightInfo.getText(), (int)sunlightInfo.getTimeRemaining() };
-  gameInfo.infoType = GameInfo::InfoType::BAND;
-  CollectiveInfo& info = gameInfo.collectiveInfo;
-  info.buildings = fillButtons(getBuildInfo());
-  info.libraryButtons = fillButtons(libraryInfo);
-  fillMinions(info);
-  fillImmigration(info);
+    info.villages.push_back(getVillageInfo(col));
+}
+
+void PlayerControl::fillChosenCreature(CollectiveInfo& info) const {
   info.chosenCreature.reset();
   if (chosenCreature)
     if (Creature* c = getCreature(*chosenCreature)) {
@@ -1350,23 +1349,6 @@ void PlayerControl::refreshGameInfo(GameInfo& gameInfo) const {
         info.chosenCreature = {*chosenCreature, getPlayerInfos(getTeams().getMembers(*getChosenTeam()),
             *chosenCreature), *getChosenTeam()};
     }
-  fillWorkshopInfo(info);
-  info.monsterHeader = "Minions: " + toString(info.minionCount) + " / " + toString(info.minionLimit);
-  info.enemyGroups = getEnemyGroups();
-  info.numResource.clear();
-  for (auto resourceId : ENUM_ALL(CollectiveResourceId)) {
-    auto& elem = CollectiveConfig::getResourceInfo(resourceId);
-    if (!elem.dontDisplay)
-      info.numResource.push_back(
-          {elem.viewId, getCollective()->numResourcePlusDebt(resourceId), elem.name});
-  }
-  info.warning = "";
-  gameInfo.time = getCollective()->getGame()->getGlobalTime();
-  gameInfo.modifiedSquares = gameInfo.totalSquares = 0;
-  for (Collective* col : getCollective()->getGame()->getCollectives()) {
-    gameInfo.modifiedSquares += col->getLevel()->getNumModifiedSquares();
-    gameInfo.totalSquares += col->getLevel()->getNumTotalSquares();
-  }
   info.teams.clear();
   for (int i : All(getTeams().getAll())) {
     TeamId team = getTeams().getAll()[i];
@@ -1378,10 +1360,9 @@ void PlayerControl::refreshGameInfo(GameInfo& gameInfo) const {
     if (getChosenTeam() == team)
       info.teams.back().highlight = true;
   }
-  info.techButtons.clear();
-  for (TechInfo tech : getTechInfo())
-    info.techButtons.push_back(tech.button);
-  gameInfo.messageBuffer = messages;
+}
+
+void PlayerControl::fillTasks(CollectiveInfo& info) const {
   info.taskMap.clear();
   for (const Task* task : getCollective()->getTaskMap().getAllTasks()) {
     optional<UniqueEntity<Creature>::Id> creature;
@@ -1389,6 +1370,71 @@ void PlayerControl::refreshGameInfo(GameInfo& gameInfo) const {
       creature = c->getUniqueId();
     info.taskMap.push_back({task->getDescription(), creature, getCollective()->getTaskMap().isPriorityTask(task)});
   }
+}
+
+static int nextSectionVersion = 0;
+
+// A section has to be regenerated if the state it was generated from changed since, or if the info object
+// was last filled by someone else.
+bool PlayerControl::isSectionOutdated(CollectiveInfo& info, GameInfoSection section, double stateTime) const {
+  auto state = make_pair(stateTime, uiVersion);
+  if (info.sectionVersions[section] != 0 && info.sectionVersions[section] == sectionVersions[section] &&
+      sectionStates[section] == state)
+    return false;
+  sectionStates[section] = state;
+  sectionVersions[section] = info.sectionVersions[section] = ++nextSectionVersion;
+  return true;
+}
+
+void PlayerControl::refreshGameInfo(GameInfo& gameInfo) const {
+  // Most of the state only changes when the model advances or the player does something. Villages and
+  // immigrants are shown with turn precision.
+  double modelTime = getModel()->getLocalTime();
+  double turn = floor(getGame()->getGlobalTime());
+  CollectiveInfo& info = gameInfo.collectiveInfo;
+  gameInfo.singleModel = getGame()->isSingleModel();
+  if (isSectionOutdated(info, GameInfoSection::VILLAGES, turn))
+    fillVillages(gameInfo.villageInfo);
+  SunlightInfo sunlightInfo = getGame()->getSunlightInfo();
+  gameInfo.sunlightInfo = { sunlightInfo.getText(), (int)sunlightInfo.getTimeRemaining() };
+  gameInfo.infoType = GameInfo::InfoType::BAND;
+  if (isSectionOutdated(info, GameInfoSection::BUILDINGS, modelTime)) {
+    info.buildings = fillButtons(getBuildInfo());
+    info.libraryButtons = fillButtons(libraryInfo);
+    info.techButtons.clear();
+    for (TechInfo tech : getTechInfo())
+      info.techButtons.push_back(tech.button);
+  }
+  if (isSectionOutdated(info, GameInfoSection::MINIONS, modelTime)) {
+    fillMinions(info);
+    fillChosenCreature(info);
+    info.monsterHeader = "Minions: " + toString(info.minionCount) + " / " + toString(info.minionLimit);
+  }
+  if (isSectionOutdated(info, GameInfoSection::IMMIGRANTS, turn))
+    fillImmigration(info);
+  if (isSectionOutdated(info, GameInfoSection::IMMIGRATION_HELP, 0))
+    fillImmigrationHelp(info);
+  if (isSectionOutdated(info, GameInfoSection::WORKSHOP, modelTime))
+    fillWorkshopInfo(info);
+  if (isSectionOutdated(info, GameInfoSection::TASKS, modelTime))
+    fillTasks(info);
+  info.enemyGroups = getEnemyGroups();
+  info.numResource.clear();
+  for (auto resourceId : ENUM_ALL(CollectiveResourceId)) {
+    auto& elem = CollectiveConfig::getResourceInfo(resourceId);
+    if (!elem.dontDisplay)
+      info.numResource.push_back(
+          {elem.viewId, getCollective()->numResourcePlusDebt(resourceId), elem.name});
+  }
+  info.warning = "";
+  gameInfo.time = getCollective()->getGame()->getGlobalTime();
+  gameInfo.modifiedSquares = gameInfo.totalSquares = 0;
+  for (Collective* col : getCollective()->getGame()->getCollectives()) {
+    gameInfo.modifiedSquares += col->getLevel()->getNumModifiedSquares();
+    gameInfo.totalSquares += col->getLevel()->getNumTotalSquares();
+  }
+  gameInfo.messageBuffer = messages;
+  info.ransom.reset();
   for (auto& elem : ransomAttacks) {
     info.ransom = {make_pair(ViewId::GOLD, *elem.getRansom()), elem.getAttackerName(),
         getCollective()->hasResource({ResourceId::GOLD, *elem.getRansom()})};
@@ -1409,6 +1455,51 @@ void PlayerControl::addMessage(const PlayerMessage& msg) {
 void PlayerControl::initialize() {
   for (Creature* c : getCreatures())
     onEvent({EventId::MOVED, c});
+  updateVisibility();
+}
+
+void PlayerControl::updateVisibility() {
+  if (movedCreatures.empty())
+    return;
+  vector<Position> tiles;
+  for (Creature* c : movedCreatures)
+    if (contains(getCreatures(), c)) {
+      vector<Position> visibleTiles = c->getVisibleTiles();
+      visibilityMap->update(c, visibleTiles);
+      for (Position pos : visibleTiles) {
+        Level* level = pos.getLevel();
+        auto mask = visibleTileMask.find(level->getUniqueId());
+        if (mask == visibleTileMask.end())
+          mask = visibleTileMask.insert(make_pair(level->getUniqueId(),
+                Table<bool>(level->getBounds(), false))).first;
+        bool& visited = mask->second[pos.getCoord()];
+        if (!visited) {
+          visited = true;
+          tiles.push_back(pos);
+        }
+      }
+    }
+  movedCreatures.clear();
+  for (Position pos : tiles) {
+    visibleTileMask.at(pos.getLevel()->getUniqueId())[pos.getCoord()] = false;
+    if (getCollective()->addKnownTile(pos))
+      updateKnownLocations(pos);
+    addToMemory(pos);
+  }
+}
+
+EnumSet<EventId> PlayerControl::getSubscribedEvents() const {
+  return {EventId::POSITION_DISCOVERED, EventId::CREATURE_EVENT, EventId::MOVED, EventId::WON_GAME,
+      EventId::TECHBOOK_READ};
+}
+
+EnumSet<EventId> PlayerControl::getDeferredEvents() const {
+  // Discovered positions come in large batches, and only the map memory depends on them.
+  return {EventId::POSITION_DISCOVERED};
+}
+
+bool PlayerControl::isInAreaOfInterest(EventId, Position) const {
+  return true;
 }
 
 void PlayerControl::onEvent(const GameEvent& event) {
@@ -1429,13 +1520,11 @@ void PlayerControl::onEvent(const GameEvent& event) {
     case EventId::MOVED: {
         Creature* c = event.get<Creature*>();
         if (contains(getCreatures(), c)) {
-          vector<Position> visibleTiles = c->getVisibleTiles();
-          visibilityMap->update(c, visibleTiles);
-          for (Position pos : visibleTiles) {
-            if (getCollective()->addKnownTile(pos))
-              updateKnownLocations(pos);
-            addToMemory(pos);
-          }
+          if (!contains(movedCreatures, c))
+            movedCreatures.push_back(c);
+          // The controlled creature's view has to be up to date before its next move.
+          if (c->isPlayer())
+            updateVisibility();
         }
       }
       break;
@@ -1830,6 +1919,7 @@ bool PlayerControl::canSelectRectangle(const BuildInfo& info) {
 }
 
 void PlayerControl::processInput(View* view, UserInput input) {
+  ++uiVersion;
   switch (input.getId()) {
     case UserInputId::MESSAGE_INFO:
         if (auto message = findMessage(input.get<PlayerMessage::Id>())) {
@@ -2402,6 +2492,7 @@ void PlayerControl::considerNightfallMessage() {
 }
 
 void PlayerControl::update(bool currentlyActive) {
+  updateVisibility();
   updateVisibleCreatures();
   vector<Creature*> addedCreatures;
   vector<Level*> currentLevels {getLevel()};
@@ -2443,6 +2534,7 @@ bool PlayerControl::isConsideredAttacking(const Creature* c) {
 const double messageTimeout = 80;
 
 void PlayerControl::tick() {
+  updateVisibility();
   for (auto& elem : messages)
     elem.setFreshness(max(0.0, elem.getFreshness() - 1.0 / messageTimeout));
   messages = filter(messages, [&] (const PlayerMessage& msg) {
@@ -2453,6 +2545,7 @@ void PlayerControl::tick() {
   if (startImpNum == -1)
     startImpNum = getCollective()->getCreatures(MinionTrait::WORKER).size();
   checkKeeperDanger();
+  checkNewImmigrants();
   for (auto attack : copyOf(ransomAttacks))
     for (const Creature* c : attack.getCreatures())
       if (getCollective()->getTerritory().contains(c->getPosition())) {
@@ -2464,6 +2557,7 @@ void PlayerControl::tick() {
       if (isConsideredAttacking(c)) {
         addMessage(PlayerMessage("You are under attack by " + attack.getAttackerName() + "!",
             MessagePriority::CRITICAL).setPosition(c->getPosition()));
+        considerTurboAlarm(OptionId::TURBO_STOP_ON_ATTACK);
         getGame()->setCurrentMusic(MusicType::BATTLE, true);
         removeElement(newAttacks, attack);
         if (auto attacker = attack.getAttacker())
@@ -2482,6 +2576,20 @@ void PlayerControl::tick() {
   }
 }
 
+void PlayerControl::considerTurboAlarm(OptionId option) {
+  if (getGame()->getOptions()->getBoolValue(option))
+    getView()->stopTurboMode();
+}
+
+void PlayerControl::checkNewImmigrants() {
+  int maxId = -1;
+  for (auto& elem : getCollective()->getImmigration().getAvailable())
+    maxId = max(maxId, elem.first);
+  if (lastImmigrantId && maxId > *lastImmigrantId)
+    considerTurboAlarm(OptionId::TURBO_STOP_ON_IMMIGRANTS);
+  lastImmigrantId = maxId;
+}
+
 bool PlayerControl::canSee(const Creature* c) const {
   return canSee(c->getPosition());
 }
@@ -2509,6 +2617,8 @@ void PlayerControl::onMemberKilled(const Creature* victim, const Creature* kille
   if (victim->isPlayer())
     onControlledKilled();
   visibilityMap->remove(victim);
+  if (auto index = findElement(movedCreatures, victim))
+    removeIndex(movedCreatures, *index);
   if (victim == getKeeper() && !getGame()->isGameOver()) {
     getGame()->gameOver(victim, getCollective()->getKills().getSize(), "enemies",
         getCollective()->getDangerLevel() + getCollective()->getPoints());
@@ -57,6 +57,8 @@ class PlayerControl : public CreatureView, public CollectiveControl {
   Creature* getKeeper();
 
   void render(View*);
+  // Processes the vision of minions that moved since the last call.
+  void updateVisibility();
 
   bool isTurnBased();
   void leaveControl();
@@ -114,6 +116,9 @@ class PlayerControl : public CreatureView, public CollectiveControl {
   HeapAllocated<EventProxy<PlayerControl>> SERIAL(eventProxy);
   friend EventProxy<PlayerControl>;
   void onEvent(const GameEvent&);
+  EnumSet<EventId> getSubscribedEvents() const;
+  EnumSet<EventId> getDeferredEvents() const;
+  bool isInAreaOfInterest(EventId, Position) const;
 
   void considerNightfallMessage();
   void considerWarning();
@@ -125,6 +130,8 @@ class PlayerControl : public CreatureView, public CollectiveControl {
   bool isConsideredAttacking(const Creature*);
 
   void checkKeeperDanger();
+  void considerTurboAlarm(OptionId);
+  void checkNewImmigrants();
   static string getWarningText(CollectiveWarning);
   void updateSquareMemory(Position);
   void updateKnownLocations(const Position&);
@@ -147,6 +154,10 @@ class PlayerControl : public CreatureView, public CollectiveControl {
   VillageInfo::Village getVillageInfo(const Collective* enemy) const;
   void fillWorkshopInfo(CollectiveInfo&) const;
   void fillImmigration(CollectiveInfo&) const;
+  void fillImmigrationHelp(CollectiveInfo&) const;
+  void fillVillages(VillageInfo&) const;
+  void fillChosenCreature(CollectiveInfo&) const;
+  void fillTasks(CollectiveInfo&) const;
   static const vector<BuildInfo>& getBuildInfo();
   static vector<BuildInfo> workshopInfo;
   static vector<BuildInfo> libraryInfo;
@@ -230,10 +241,20 @@ class PlayerControl : public CreatureView, public CollectiveControl {
   void updateVisibleCreatures();
   vector<Vec2> SERIAL(visibleEnemies);
   HeapAllocated<VisibilityMap> SERIAL(visibilityMap);
+  vector<Creature*> movedCreatures;
+  // Marks tiles already processed during updateVisibility, cleared after each call.
+  map<LevelId, Table<bool>> visibleTileMask;
   set<const Location*> SERIAL(knownLocations);
   bool firstRender = true;
   bool isNight = true;
   optional<UniqueEntity<Creature>::Id> draggedCreature;
   map<int, ImmigrantDataInfo::AutoState> SERIAL(immigrantAutoState);
+  // The highest id of the available immigrants seen in the last tick.
+  optional<int> lastImmigrantId;
+  bool isSectionOutdated(CollectiveInfo&, GameInfoSection, double stateTime) const;
+  // Bumped on every user input, as it may change anything shown in the GameInfo.
+  int uiVersion = 0;
+  mutable EnumMap<GameInfoSection, pair<double, int>> sectionStates;
+  mutable EnumMap<GameInfoSection, int> sectionVersions;
 };
 
@@ -383,6 +383,11 @@ PItem Position::removeItem(Item* it) {
   return modSquare()->removeItem(*this, it);
 }
 
+PItem Position::removeItem(Item* it, int count) {
+  CHECK(isValid());
+  return modSquare()->removeItem(*this, it, count);
+}
+
 Inventory& Position::modInventory() const {
   if (!isValid()) {
     static Inventory empty;
@@ -536,6 +541,9 @@ void Position::fireDamage(double amount) {
     it->fireDamage(amount, *this);
   for (Trigger* t : getTriggers())
     t->fireDamage(amount);
+  // Items and triggers that caught fire have to be ticked. The square goes back to sleep if nothing did.
+  if (isValid() && (!getItems().empty() || !getTriggers().empty()))
+    level->addTickingSquare(getCoord());
 }
 
 bool Position::needsMemoryUpdate() const {
@@ -648,6 +656,7 @@ void Position::throwItem(vector<PItem> item, const Attack& attack, int maxDist,
 
 void Position::updateConnectivity() const {
   if (isValid()) {
+    level->addMovementChange(coord);
     for (auto& elem : level->sectors)
       if (canNavigate(elem.first))
         elem.second.add(coord);
@@ -79,6 +79,7 @@ class Position {
   vector<Item*> getItems(function<bool (Item*)> predicate) const;
   const vector<Item*>& getItems(ItemIndex) const;
   PItem removeItem(Item*);
+  PItem removeItem(Item*, int count);
   Inventory& modInventory() const;
   const Inventory& getInventory() const;
   vector<PItem> removeItems(vector<Item*>);
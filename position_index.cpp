@@ -0,0 +1,137 @@
+#include "stdafx.h"
+#include "position_index.h"
+#include "level.h"
+
+static const int bucketSize = 8;
+
+PositionIndex::LevelBuckets* PositionIndex::getBuckets(const Level* level) {
+  auto it = levels.find(level->getUniqueId());
+  if (it == levels.end())
+    return nullptr;
+  return &it->second;
+}
+
+const PositionIndex::LevelBuckets* PositionIndex::getBuckets(const Level* level) const {
+  auto it = levels.find(level->getUniqueId());
+  if (it == levels.end())
+    return nullptr;
+  return &it->second;
+}
+
+void PositionIndex::insert(Position pos) {
+  // Positions outside of the level can't be targets, so they are not indexed.
+  if (!pos.isValid())
+    return;
+  Level* level = pos.getLevel();
+  LevelBuckets* levelBuckets = getBuckets(level);
+  if (!levelBuckets) {
+    Rectangle bounds = level->getBounds();
+    levelBuckets = &levels.insert(make_pair(level->getUniqueId(), LevelBuckets{
+        Table<vector<Position>>((bounds.right() + bucketSize - 1) / bucketSize,
+            (bounds.bottom() + bucketSize - 1) / bucketSize), 0})).first->second;
+  }
+  auto& bucket = levelBuckets->buckets[pos.getCoord() / bucketSize];
+  if (!contains(bucket, pos)) {
+    bucket.push_back(pos);
+    ++levelBuckets->count;
+  }
+}
+
+void PositionIndex::erase(Position pos) {
+  if (!pos.isValid())
+    return;
+  if (LevelBuckets* levelBuckets = getBuckets(pos.getLevel())) {
+    auto& bucket = levelBuckets->buckets[pos.getCoord() / bucketSize];
+    if (auto index = findElement(bucket, pos)) {
+      removeIndex(bucket, *index);
+      --levelBuckets->count;
+    }
+  }
+}
+
+void PositionIndex::clear() {
+  levels.clear();
+}
+
+// Calls fun for the buckets that are exactly 'ring' buckets away from 'center' in the max metric.
+template <typename Fun>
+static void forEachInRing(const Table<vector<Position>>& buckets, Vec2 center, int ring, Fun fun) {
+  auto visit = [&] (Vec2 v) {
+    if (v.inRectangle(buckets.getBounds()) && !buckets[v].empty())
+      fun(buckets[v]);
+  };
+  if (ring == 0) {
+    visit(center);
+    return;
+  }
+  for (int x = center.x - ring; x <= center.x + ring; ++x) {
+    visit(Vec2(x, center.y - ring));
+    visit(Vec2(x, center.y + ring));
+  }
+  for (int y = center.y - ring + 1; y < center.y + ring; ++y) {
+    visit(Vec2(center.x - ring, y));
+    visit(Vec2(center.x + ring, y));
+  }
+}
+
+// Positions in a bucket 'ring' buckets away are at least this far.
+static int getMinRingDist(int ring) {
+  return max(0, (ring - 1) * bucketSize + 1);
+}
+
+static int getNumRings(const Table<vector<Position>>& buckets, Vec2 center) {
+  auto bounds = buckets.getBounds();
+  return max(max(center.x, bounds.right() - 1 - center.x), max(center.y, bounds.bottom() - 1 - center.y)) + 1;
+}
+
+optional<int> PositionIndex::getClosestDist(Position from, const function<bool(Position)>& predicate) const {
+  optional<int> ret;
+  auto update = [&] (const vector<Position>& bucket) {
+    for (auto& pos : bucket)
+      if ((!ret || pos.dist8(from) < *ret) && predicate(pos))
+        ret = pos.dist8(from);
+  };
+  const LevelBuckets* levelBuckets = from.isValid() ? getBuckets(from.getLevel()) : nullptr;
+  if (levelBuckets) {
+    Vec2 center = from.getCoord() / bucketSize;
+    int visited = 0;
+    for (int ring = 0; ring < getNumRings(levelBuckets->buckets, center) && visited < levelBuckets->count; ++ring) {
+      if (ret && getMinRingDist(ring) > *ret)
+        break;
+      forEachInRing(levelBuckets->buckets, center, ring, [&] (const vector<Position>& bucket) {
+          visited += bucket.size();
+          update(bucket);
+      });
+    }
+    if (ret)
+      return ret;
+  }
+  for (auto& elem : levels)
+    if (&elem.second != levelBuckets)
+      for (Vec2 v : elem.second.buckets.getBounds())
+        update(elem.second.buckets[v]);
+  return ret;
+}
+
+void PositionIndex::getWithin(Position from, int maxDist, const function<bool(Position)>& predicate,
+    vector<Position>& result) const {
+  auto add = [&] (const vector<Position>& bucket) {
+    for (auto& pos : bucket)
+      if (pos.dist8(from) <= maxDist && predicate(pos))
+        result.push_back(pos);
+  };
+  const LevelBuckets* levelBuckets = from.isValid() ? getBuckets(from.getLevel()) : nullptr;
+  if (levelBuckets) {
+    Vec2 center = from.getCoord() / bucketSize;
+    for (int ring = 0; ring < getNumRings(levelBuckets->buckets, center) && getMinRingDist(ring) <= maxDist; ++ring)
+      forEachInRing(levelBuckets->buckets, center, ring, add);
+  }
+  // Positions on other levels are further than anything on the same level, so they are only
+  // looked at when maxDist doesn't fit within the level.
+  Rectangle bounds = from.isValid() ? from.getLevel()->getBounds() : Rectangle(0, 0);
+  if (maxDist >= max(bounds.width(), bounds.height()))
+    for (auto& elem : levels)
+      if (&elem.second != levelBuckets)
+        for (Vec2 v : elem.second.buckets.getBounds())
+          add(elem.second.buckets[v]);
+}
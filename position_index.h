@@ -0,0 +1,29 @@
+#pragma once
+
+#include "util.h"
+#include "position.h"
+
+// Set of positions bucketed by level and coordinates. Finding the ones closest to a given position
+// only looks at the buckets around it, instead of scanning the whole set.
+class PositionIndex {
+  public:
+  void insert(Position);
+  void erase(Position);
+  void clear();
+
+  // The smallest dist8 from 'from' to a position that satisfies the predicate.
+  optional<int> getClosestDist(Position from, const function<bool(Position)>& predicate) const;
+
+  // Appends positions that satisfy the predicate and are within maxDist (dist8) of 'from'.
+  void getWithin(Position from, int maxDist, const function<bool(Position)>& predicate,
+      vector<Position>& result) const;
+
+  private:
+  struct LevelBuckets {
+    Table<vector<Position>> buckets;
+    int count;
+  };
+  LevelBuckets* getBuckets(const Level*);
+  const LevelBuckets* getBuckets(const Level*) const;
+  map<LevelId, LevelBuckets> levels;
+};
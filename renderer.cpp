@@ -15,6 +15,12 @@
 
 #include "stdafx.h"
 #include "dirent.h"
+#include <sys/stat.h>
+#ifndef WINDOWS
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include "renderer.h"
 #include "view_object.h"
@@ -115,6 +121,20 @@ Texture::~Texture() {
 
 static int totalTex = 0;
 
+static int getPixelFormat(SDL::SDL_Surface* image) {
+  if (image->format->BytesPerPixel == 4) {
+    if (image->format->Rmask == 0x000000ff)
+      return GL_RGBA;
+    else
+      return GL_BGRA;
+  } else {
+    if (image->format->Rmask == 0x000000ff)
+      return GL_RGB;
+    else
+      return GL_BGR;
+  }
+}
+
 optional<SDL::GLenum> Texture::loadFromMaybe(SDL::SDL_Surface* image) {
   if (!texId) {
     texId = 0;
@@ -128,18 +148,7 @@ optional<SDL::GLenum> Texture::loadFromMaybe(SDL::SDL_Surface* image) {
   SDL::glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
   SDL::glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
   checkOpenglError();
-  int mode = GL_RGB;
-  if (image->format->BytesPerPixel == 4) {
-    if (image->format->Rmask == 0x000000ff)
-      mode = GL_RGBA;
-    else
-      mode = GL_BGRA;
-  } else {
-    if (image->format->Rmask == 0x000000ff)
-      mode = GL_RGB;
-    else
-      mode = GL_BGR;
-  }
+  int mode = getPixelFormat(image);
   SDL::glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
   SDL::glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
   SDL::glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
@@ -153,6 +162,24 @@ optional<SDL::GLenum> Texture::loadFromMaybe(SDL::SDL_Surface* image) {
   return none;
 }
 
+optional<SDL::GLenum> Texture::updateFromMaybe(SDL::SDL_Surface* image, Rectangle area) {
+  CHECK(texId && size == Vec2(image->w, image->h));
+  SDL::glBindTexture(GL_TEXTURE_2D, (*texId));
+  SDL::glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  SDL::glPixelStorei(GL_UNPACK_ROW_LENGTH, image->pitch / image->format->BytesPerPixel);
+  SDL::glPixelStorei(GL_UNPACK_SKIP_PIXELS, area.left());
+  SDL::glPixelStorei(GL_UNPACK_SKIP_ROWS, area.top());
+  SDL::glTexSubImage2D(GL_TEXTURE_2D, 0, area.left(), area.top(), area.width(), area.height(),
+      getPixelFormat(image), GL_UNSIGNED_BYTE, image->pixels);
+  auto error = SDL::glGetError();
+  SDL::glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  SDL::glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+  SDL::glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+  if (error != GL_NO_ERROR)
+    return error;
+  return none;
+}
+
 Texture::Texture(const string& path, int px, int py, int w, int h) {
   SDL::SDL_Surface* image = SDL::IMG_Load(path.c_str());
   CHECK(image) << SDL::IMG_GetError();
@@ -201,39 +228,20 @@ const Vec2& Texture::getSize() const {
   return size;
 }
 
-void Texture::addTexCoord(int x, int y) const {
-  SDL::glTexCoord2f((float)x / size.x, (float)y / size.y);
-}
-
 Texture::Texture() {
 }
   
-void Texture::render(Vec2 a, Vec2 b, Vec2 p, Vec2 k, optional<Color> color, bool vFlip, bool hFlip) const {
+void Texture::render(SpriteBatch& batch, Vec2 a, Vec2 b, Vec2 p, Vec2 k, optional<Color> color, bool vFlip,
+    bool hFlip) const {
   if (vFlip)
     swap(p.y, k.y);
   if (hFlip)
     swap(p.x, k.x);
-  SDL::glBindTexture(GL_TEXTURE_2D, (*texId));
-  checkOpenglError();
-  SDL::glEnable(GL_TEXTURE_2D);
-  SDL::glBegin(GL_QUADS);
-  if (color)
-    color->applyGl();
-  else
-    SDL::glColor3f(1, 1, 1);
-  addTexCoord(p.x, p.y);
-  SDL::glVertex2f(a.x, a.y);
-  addTexCoord(k.x, p.y);
-  SDL::glVertex2f(b.x, a.y);
-  addTexCoord(k.x, k.y);
-  SDL::glVertex2f(b.x, b.y);
-  addTexCoord(p.x, k.y);
-  SDL::glVertex2f(a.x, b.y);
-  SDL::glEnd();
-  SDL::glDisable(GL_TEXTURE_2D);
-  checkOpenglError();
+  batch.addQuad(*texId, size, a, b, p, k, color.get_value_or(colors[ColorId::WHITE]));
 }
 
+static const Vec2 fontCacheSize(512, 512);
+
 static float sizeConv(int size) {
   return 1.15 * (float)size;
 }
@@ -245,12 +253,30 @@ int Renderer::getTextLength(const string& s, int size, FontId font) {
 Vec2 Renderer::getTextSize(const string& s, int size, FontId id) {
   if (s.empty())
     return Vec2(0, 0);
-  float minx, maxx, miny, maxy;
-  int font = getFont(id);
-  sth_dim_text(fontStash, font, sizeConv(size), s.c_str(), &minx, &miny, &maxx, &maxy);
-  float height;
-  sth_vmetrics(fontStash, font, sizeConv(size), nullptr, nullptr, &height);
-  return Vec2(maxx - minx, height);
+  return textSizeCache->get([this] (const string& s, int size, int id) {
+      float minx, maxx, miny, maxy;
+      int font = getFont(FontId(id));
+      sth_dim_text(fontStash, font, sizeConv(size), s.c_str(), &minx, &miny, &maxx, &maxy);
+      float height;
+      sth_vmetrics(fontStash, font, sizeConv(size), nullptr, nullptr, &height);
+      return Vec2(maxx - minx, height);
+  }, 0, s, size, int(id));
+}
+
+// The glyphs are placed with the top left corner of the text at (0, 0), so they only need to be shifted
+// by an integer offset when drawn.
+Renderer::GlyphRun Renderer::getGlyphRun(const string& s, int size, FontId id) {
+  return glyphRunCache->get([this] (const string& s, int size, int id) {
+      vector<sth_glyph_quad> quads(s.size());
+      int num = sth_get_text_quads(fontStash, getFont(FontId(id)), sizeConv(size), 0,
+          getTextSize(s, size, FontId(id)).y * 0.9, s.c_str(), quads.data());
+      auto ret = make_shared<vector<GlyphQuad>>();
+      for (int i : Range(num)) {
+        auto& q = quads[i];
+        ret->push_back({q.texture, Vec2(q.x0, q.y0), Vec2(q.x1, q.y1), Vec2(q.s0, q.t0), Vec2(q.s1, q.t1)});
+      }
+      return GlyphRun(ret);
+  }, 0, s, size, int(id));
 }
 
 int Renderer::getFont(Renderer::FontId id) {
@@ -283,10 +309,11 @@ void Renderer::drawText(FontId id, int size, Color color, int x, int y, const st
           default:
             break;
         }
-        sth_begin_draw(fontStash);
-        color.applyGl();
-        sth_draw_text(fontStash, getFont(id), sizeConv(size), ox + x, oy + y + (dim.y * 0.9), s.c_str(), nullptr);
-        sth_end_draw(fontStash);
+        // Glyphs go through the sprite batch, so consecutive strings are drawn with a single call.
+        Vec2 offset(ox + x, oy + y);
+        for (auto& quad : *getGlyphRun(s, size, id))
+          spriteBatch.addQuad(quad.texture, fontCacheSize, quad.a + offset, quad.b + offset, quad.texA, quad.texB,
+              color);
     });
 }
 
@@ -312,7 +339,7 @@ void Renderer::drawTextWithHotkey(Color color, int x, int y, const string& text,
 void Renderer::drawImage(int px, int py, const Texture& image, double scale, optional<Color> color) {
   Vec2 p(px, py);
   addRenderElem([this, p, &image, scale, color] {
-    image.render(p, p + image.getSize() * scale, Vec2(0, 0), image.getSize(), color);
+    image.render(spriteBatch, p, p + image.getSize() * scale, Vec2(0, 0), image.getSize(), color);
   });
 }
 
@@ -328,9 +355,9 @@ void Renderer::drawSprite(Vec2 pos, Vec2 source, Vec2 size, const Texture& t, op
     optional<Color> color, bool vFlip, bool hFlip) {
   addRenderElem([this, &t, pos, source, size, targetSize, color, vFlip, hFlip] {
       if (targetSize)
-        t.render(pos, pos + *targetSize, source, source + size, color, vFlip, hFlip);
+        t.render(spriteBatch, pos, pos + *targetSize, source, source + size, color, vFlip, hFlip);
       else
-        t.render(pos, pos + size, source, source + size, color, vFlip, hFlip);
+        t.render(spriteBatch, pos, pos + size, source, source + size, color, vFlip, hFlip);
   });
 }
 
@@ -339,24 +366,15 @@ void Renderer::drawFilledRectangle(const Rectangle& t, Color color, optional<Col
     Vec2 a = t.topLeft();
     Vec2 b = t.bottomRight();
     if (outline) {
-      SDL::glLineWidth(2);
-      SDL::glBegin(GL_LINE_LOOP);
-      outline->applyGl();
-      SDL::glVertex2f(a.x, a.y);
-      SDL::glVertex2f(b.x, a.y);
-      SDL::glVertex2f(b.x, b.y);
-      SDL::glVertex2f(a.x, b.y);
-      SDL::glEnd();
+      Vec2 w(1, 1);
+      spriteBatch.addQuad(a - w, Vec2(b.x, a.y) + w, *outline);
+      spriteBatch.addQuad(Vec2(a.x, b.y) - w, b + w, *outline);
+      spriteBatch.addQuad(Vec2(a.x - 1, a.y + 1), Vec2(a.x + 1, b.y - 1), *outline);
+      spriteBatch.addQuad(Vec2(b.x - 1, a.y + 1), Vec2(b.x + 1, b.y - 1), *outline);
       a += Vec2(2, 2);
       b -= Vec2(2, 2);
     }
-    SDL::glBegin(GL_QUADS);
-    color.applyGl();
-    SDL::glVertex2f(a.x, a.y);
-    SDL::glVertex2f(b.x, a.y);
-    SDL::glVertex2f(b.x, b.y);
-    SDL::glVertex2f(a.x, b.y);
-    SDL::glEnd();
+    spriteBatch.addQuad(a, b, color);
   });
 }
 
@@ -369,11 +387,6 @@ void Renderer::addQuad(const Rectangle& r, Color color) {
 }
 
 void Renderer::drawQuads() {
-/*  if (!quads.empty()) {
-    vector<Vertex>& quadsTmp = quads;
-    addRenderElem([this, quadsTmp] { display.draw(&quadsTmp[0], quadsTmp.size(), sf::Quads); });
-    quads.clear();
-  }*/
 }
 
 void Renderer::setScissor(optional<Rectangle> s) {
@@ -382,6 +395,7 @@ void Renderer::setScissor(optional<Rectangle> s) {
 
 void Renderer::setGlScissor(optional<Rectangle> s) {
   if (s != scissor) {
+    spriteBatch.flush();
     if (s) {
       SDL::glScissor(s->left(), getSize().y - s->bottom(), s->width(), s->height());
       SDL::glEnable(GL_SCISSOR_TEST);
@@ -408,6 +422,47 @@ void Renderer::popLayer() {
   layerStack.pop();
 }
 
+class Renderer::DrawList {
+  public:
+  array<vector<function<void()>>, 2> elems;
+  optional<Rectangle> scissor;
+};
+
+void Renderer::startDrawList() {
+  array<int, 2> starts;
+  for (int i : All(renderList))
+    starts[i] = renderList[i].size();
+  drawListStarts.push(starts);
+}
+
+shared_ptr<Renderer::DrawList> Renderer::finishDrawList() {
+  CHECK(!drawListStarts.empty());
+  auto starts = drawListStarts.top();
+  drawListStarts.pop();
+  auto ret = make_shared<DrawList>();
+  ret->scissor = scissor;
+  for (int i : All(renderList)) {
+    auto begin = renderList[i].begin() + starts[i];
+    std::move(begin, renderList[i].end(), std::back_inserter(ret->elems[i]));
+    renderList[i].erase(begin, renderList[i].end());
+  }
+  // The elements were moved out of renderList, so they have to be put back for this frame.
+  replayDrawList(ret);
+  return ret;
+}
+
+bool Renderer::replayDrawList(const shared_ptr<DrawList>& list) {
+  if (list->scissor != scissor)
+    return false;
+  for (int i : All(renderList))
+    if (!list->elems[i].empty())
+      renderList[i].push_back([list, i] {
+          for (auto& elem : list->elems[i])
+            elem();
+      });
+  return true;
+}
+
 Vec2 Renderer::getSize() {
   return Vec2(width / zoom, height / zoom);
 }
@@ -511,7 +566,7 @@ void Renderer::printSystemInfo(ostream& out) {
 }
 
 void Renderer::loadFonts(const string& fontPath, FontSet& fonts) {
-  CHECK(fontStash = sth_create(512, 512)) << "Error initializing fonts";
+  CHECK(fontStash = sth_create(fontCacheSize.x, fontCacheSize.y)) << "Error initializing fonts";
   fonts.textFont = sth_add_font(fontStash, (fontPath + "/Lato-Bol.ttf").c_str());
   fonts.symbolFont = sth_add_font(fontStash, (fontPath + "/Symbola.ttf").c_str());
   CHECK(fonts.textFont >= 0) << "Error loading " << fontPath + "/Lato-Bol.ttf";
@@ -522,7 +577,8 @@ void Renderer::showError(const string& s) {
   SDL_ShowSimpleMessageBox(SDL::SDL_MESSAGEBOX_ERROR, "Error", s.c_str(), window);
 }
 
-Renderer::Renderer(const string& title, Vec2 nominal, const string& fontPath) : nominalSize(nominal) {
+Renderer::Renderer(const string& title, Vec2 nominal, const string& fontPath) : nominalSize(nominal),
+    spriteBatch(SpriteBatch::openGlBackend()), textSizeCache(5000), glyphRunCache(2000) {
 
   CHECK(SDL::SDL_Init(SDL_INIT_AUDIO | SDL_INIT_VIDEO | SDL_INIT_EVENTS) >= 0) << SDL::SDL_GetError();
   SDL::SDL_GL_SetAttribute(SDL::SDL_GL_CONTEXT_MAJOR_VERSION, 2 );
@@ -624,12 +680,12 @@ const static string imageSuf = ".png";
 
 bool Renderer::loadAltTilesFromDir(const string& path, Vec2 altSize) {
   altTileSize.push_back(altSize);
-  return loadTilesFromDir(path, altTiles, altSize, 720 * altSize.x / tileSize.back().x);
+  return loadTilesFromDir(path, altTiles, altSize, 720 * altSize.x / tileSize.back().x, none);
 }
 
-bool Renderer::loadTilesFromDir(const string& path, Vec2 size) {
+bool Renderer::loadTilesFromDir(const string& path, Vec2 size, optional<string> cachePath) {
   tileSize.push_back(size);
-  return loadTilesFromDir(path, tiles, size, 720);
+  return loadTilesFromDir(path, tiles, size, 720, cachePath);
 }
 
 SDL::SDL_Surface* Renderer::createSurface(int w, int h) {
@@ -638,10 +694,10 @@ SDL::SDL_Surface* Renderer::createSurface(int w, int h) {
   return ret;
 }
 
-bool Renderer::loadTilesFromDir(const string& path, vector<Texture>& tiles, Vec2 size, int setWidth) {
+static optional<vector<string>> getTileFiles(const string& path) {
   DIR* dir = opendir(path.c_str());
   if (!dir)
-    return false;
+    return none;
   vector<string> files;
   while (dirent* ent = readdir(dir)) {
     string name(ent->d_name);
@@ -649,24 +705,227 @@ bool Renderer::loadTilesFromDir(const string& path, vector<Texture>& tiles, Vec2
     if (endsWith(name, imageSuf))
       files.push_back(name);
   }
-  int rowLength = setWidth / size.x;
-  SDL::SDL_Surface* image = createSurface(setWidth, ((files.size() + rowLength - 1) / rowLength) * size.y);
-  CHECK(image) << SDL::SDL_GetError();
-  for (int i : All(files)) {
-    SDL::SDL_Surface* im = SDL::IMG_Load((path + "/" + files[i]).c_str());
-    CHECK(im) << files[i] << ": "<< SDL::IMG_GetError();
-    CHECK(im->w == size.x && im->h == size.y) << files[i] << " has wrong size " << im->w << " " << im->h;
-    SDL::SDL_Rect offset;
-    offset.x = size.x * (i % rowLength);
-    offset.y = size.y * (i / rowLength);
-    SDL_BlitSurface(im, nullptr, image, &offset);
-    CHECK(!tileCoords.count(files[i])) << "Duplicate name " << files[i];
-    tileCoords[files[i].substr(0, files[i].size() - imageSuf.size())] =
-        {{i % rowLength, i / rowLength}, int(tiles.size())};
-    SDL::SDL_FreeSurface(im);
+  closedir(dir);
+  // Sorting keeps the atlas layout independent of the directory order, so it can be cached.
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+static size_t getTileFilesHash(const string& path, const vector<string>& files, Vec2 size, int setWidth) {
+  size_t ret = combineHash(size, setWidth);
+  for (auto& file : files) {
+    struct stat info;
+    CHECK(!stat((path + "/" + file).c_str(), &info)) << "Couldn't stat " << file;
+    ret = combineHash(ret, file, (long long) info.st_size, (long long) info.st_mtime);
+  }
+  return ret;
+}
+
+const static string atlasMagic = "KeeperRL tile atlas 1";
+
+class MappedFile {
+  public:
+  MappedFile(const string& path) {
+#ifdef WINDOWS
+    ifstream in(path, std::ios::binary);
+    if (in) {
+      buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+      data = buffer.data();
+      size = buffer.size();
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+    struct stat info;
+    if (!fstat(fd, &info) && info.st_size > 0) {
+      void* ptr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (ptr != MAP_FAILED) {
+        data = (const char*) ptr;
+        size = info.st_size;
+      }
+    }
+    close(fd);
+#endif
+  }
+
+  ~MappedFile() {
+#ifndef WINDOWS
+    if (data)
+      munmap((void*) data, size);
+#endif
+  }
+
+  MappedFile(const MappedFile&) = delete;
+
+  const char* data = nullptr;
+  size_t size = 0;
+
+  private:
+#ifdef WINDOWS
+  vector<char> buffer;
+#endif
+};
+
+class AtlasReader {
+  public:
+  AtlasReader(const MappedFile& f) : file(f) {}
+
+  template <typename T>
+  optional<T> read() {
+    if (pos + sizeof(T) > file.size)
+      return none;
+    T ret;
+    memcpy(&ret, file.data + pos, sizeof(T));
+    pos += sizeof(T);
+    return ret;
   }
-  tiles.push_back(Texture(image));
+
+  optional<string> readString() {
+    if (auto length = read<int32_t>())
+      if (*length >= 0 && pos + *length <= file.size) {
+        string ret(file.data + pos, *length);
+        pos += *length;
+        return ret;
+      }
+    return none;
+  }
+
+  const char* getPointer(size_t length) {
+    if (pos + length > file.size)
+      return nullptr;
+    return file.data + pos;
+  }
+
+  private:
+  const MappedFile& file;
+  size_t pos = 0;
+};
+
+static optional<Texture> loadTileAtlas(const string& cachePath, size_t hash, const vector<string>& files) {
+  MappedFile file(cachePath);
+  if (!file.data)
+    return none;
+  AtlasReader reader(file);
+  auto magic = reader.readString();
+  auto fileHash = reader.read<uint64_t>();
+  if (!magic || *magic != atlasMagic || !fileHash || *fileHash != uint64_t(hash))
+    return none;
+  auto width = reader.read<int32_t>();
+  auto height = reader.read<int32_t>();
+  auto numFiles = reader.read<int32_t>();
+  if (!width || !height || !numFiles || *numFiles != files.size())
+    return none;
+  for (auto& name : files) {
+    auto fileName = reader.readString();
+    if (!fileName || *fileName != name)
+      return none;
+  }
+  int pitch = *width * 4;
+  auto pixels = reader.getPointer(size_t(pitch) * *height);
+  if (!pixels)
+    return none;
+  SDL::SDL_Surface* image = SDL::SDL_CreateRGBSurfaceFrom((void*) pixels, *width, *height, 32, pitch,
+      0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
+  CHECK(image) << SDL::SDL_GetError();
+  Texture ret(image);
   SDL::SDL_FreeSurface(image);
+  INFO << "Loaded tile atlas " << cachePath;
+  return std::move(ret);
+}
+
+template <typename T>
+static void writeBinary(ofstream& out, const T& elem) {
+  out.write((const char*) &elem, sizeof(T));
+}
+
+static void writeBinary(ofstream& out, const string& s) {
+  writeBinary(out, int32_t(s.size()));
+  out.write(s.data(), s.size());
+}
+
+static void saveTileAtlas(const string& cachePath, size_t hash, const vector<string>& files,
+    SDL::SDL_Surface* image) {
+  // Write to a temporary file first, so that a crash never leaves a truncated atlas behind.
+  string tmpPath = cachePath + ".tmp";
+  {
+    ofstream out(tmpPath, std::ios::binary);
+    if (!out)
+      return;
+    writeBinary(out, atlasMagic);
+    writeBinary(out, uint64_t(hash));
+    writeBinary(out, int32_t(image->w));
+    writeBinary(out, int32_t(image->h));
+    writeBinary(out, int32_t(files.size()));
+    for (auto& name : files)
+      writeBinary(out, name);
+    for (int y : Range(image->h))
+      out.write((const char*) image->pixels + y * image->pitch, image->w * 4);
+    if (!out)
+      return;
+  }
+  std::remove(cachePath.c_str());
+  if (std::rename(tmpPath.c_str(), cachePath.c_str()))
+    INFO << "Couldn't write tile atlas " << cachePath;
+}
+
+// Decodes the images on all available cores. Blitting is left to the caller.
+static vector<SDL::SDL_Surface*> loadImagesInParallel(const string& path, const vector<string>& files) {
+  // Load the PNG decoder up front, lazy initialization inside IMG_Load isn't thread-safe.
+  SDL::IMG_Init(SDL::IMG_INIT_PNG);
+  vector<SDL::SDL_Surface*> ret(files.size(), nullptr);
+  atomic<int> nextFile(0);
+  auto worker = [&] {
+    for (int i = nextFile++; i < files.size(); i = nextFile++)
+      ret[i] = SDL::IMG_Load((path + "/" + files[i]).c_str());
+  };
+  int numThreads = max<int>(1, min<int>(files.size(), thread::hardware_concurrency()));
+  vector<thread> threads;
+  for (int i : Range(numThreads - 1))
+    threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads)
+    t.join();
+  return ret;
+}
+
+bool Renderer::loadTilesFromDir(const string& path, vector<Texture>& tiles, Vec2 size, int setWidth,
+    optional<string> cachePath) {
+  auto files = getTileFiles(path);
+  if (!files)
+    return false;
+  int rowLength = setWidth / size.x;
+  optional<size_t> hash;
+  optional<Texture> atlas;
+  if (cachePath) {
+    hash = getTileFilesHash(path, *files, size, setWidth);
+    atlas = loadTileAtlas(*cachePath, *hash, *files);
+  }
+  if (!atlas) {
+    SDL::SDL_Surface* image = createSurface(setWidth, ((files->size() + rowLength - 1) / rowLength) * size.y);
+    CHECK(image) << SDL::SDL_GetError();
+    vector<SDL::SDL_Surface*> images = loadImagesInParallel(path, *files);
+    for (int i : All(*files)) {
+      SDL::SDL_Surface* im = images[i];
+      CHECK(im) << (*files)[i] << ": "<< SDL::IMG_GetError();
+      CHECK(im->w == size.x && im->h == size.y) << (*files)[i] << " has wrong size " << im->w << " " << im->h;
+      SDL::SDL_Rect offset;
+      offset.x = size.x * (i % rowLength);
+      offset.y = size.y * (i / rowLength);
+      SDL_BlitSurface(im, nullptr, image, &offset);
+      SDL::SDL_FreeSurface(im);
+    }
+    if (cachePath)
+      saveTileAtlas(*cachePath, *hash, *files, image);
+    atlas.emplace(image);
+    SDL::SDL_FreeSurface(image);
+  }
+  for (int i : All(*files)) {
+    const string& name = (*files)[i];
+    CHECK(!tileCoords.count(name)) << "Duplicate name " << name;
+    tileCoords[name.substr(0, name.size() - imageSuf.size())] = {{i % rowLength, i / rowLength}, int(tiles.size())};
+  }
+  tiles.push_back(std::move(*atlas));
   return true;
 }
 
@@ -680,18 +939,27 @@ Vec2 Renderer::getNominalSize() const {
 }
 
 void Renderer::drawAndClearBuffer() {
+  auto startTime = steady_clock::now();
+  spriteBatch.resetStats();
   for (int i : All(renderList)) {
     for (auto& elem : renderList[i])
       elem();
     renderList[i].clear();
   }
   setGlScissor(none);
+  spriteBatch.flush();
+  lastFrameStats = {spriteBatch.getStats().drawCalls, spriteBatch.getStats().quads,
+      duration_cast<milliseconds>(steady_clock::now() - startTime)};
   SDL::SDL_GL_SwapWindow(window);
   SDL::glClear(GL_COLOR_BUFFER_BIT);
   SDL::glClearColor(0.0, 0.0, 0.0, 0.0);
 
 }
 
+const Renderer::FrameStats& Renderer::getLastFrameStats() const {
+  return lastFrameStats;
+}
+
 void Renderer::resize(int w, int h) {
   width = w;
   height = h;
@@ -17,6 +17,8 @@
 
 #include "sdl.h"
 #include "util.h"
+#include "sprite_batch.h"
+#include "call_cache.h"
 
 struct Color : public SDL::SDL_Color {
   Color(Uint8, Uint8, Uint8, Uint8 = 255);
@@ -88,6 +90,8 @@ class Texture {
   static optional<Texture> loadMaybe(const string& path);
 
   optional<SDL::GLenum> loadFromMaybe(SDL::SDL_Surface*);
+  // Uploads only the given part of the surface, which must have the size of the texture.
+  optional<SDL::GLenum> updateFromMaybe(SDL::SDL_Surface*, Rectangle area);
   const Vec2& getSize() const;
 
   ~Texture();
@@ -95,9 +99,8 @@ class Texture {
   private:
   Texture();
   friend class Renderer;
-  void render(Vec2 screenP, Vec2 screenK, Vec2 srcP, Vec2 srck, optional<Color> = none,
+  void render(SpriteBatch&, Vec2 screenP, Vec2 screenK, Vec2 srcP, Vec2 srck, optional<Color> = none,
       bool vFlip = false, bool hFlip = false) const;
-  void addTexCoord(int x, int y) const;
   optional<SDL::GLuint> texId;
   Vec2 size;
   string path;
@@ -161,8 +164,8 @@ class Renderer {
   void drawQuads();
   static Color getBleedingColor(const ViewObject&);
   Vec2 getSize();
-  bool loadTilesFromDir(const string& path, Vec2 size);
-  bool loadTilesFromDir(const string& path, vector<Texture>&, Vec2 size, int setWidth);
+  bool loadTilesFromDir(const string& path, Vec2 size, optional<string> cachePath = none);
+  bool loadTilesFromDir(const string& path, vector<Texture>&, Vec2 size, int setWidth, optional<string> cachePath);
   bool loadAltTilesFromDir(const string& path, Vec2 altSize);
 
   void drawAndClearBuffer();
@@ -176,12 +179,27 @@ class Renderer {
   void setTopLayer();
   void popLayer();
 
+  // Records the draw calls made between startDrawList and finishDrawList, so that they can be repeated
+  // in later frames without running the code that made them. Draw lists can be nested.
+  class DrawList;
+  void startDrawList();
+  shared_ptr<DrawList> finishDrawList();
+  // Returns false if the list can't be replayed, because it was recorded with a different scissor.
+  bool replayDrawList(const shared_ptr<DrawList>&);
+
   void startMonkey();
   bool isMonkey();
   void setCursorPath(const string& path, const string& pathClicked);
 
   void printSystemInfo(ostream&);
 
+  struct FrameStats {
+    int drawCalls;
+    int quads;
+    milliseconds cpuTime;
+  };
+  const FrameStats& getLastFrameStats() const;
+
   TileCoord getTileCoord(const string&);
   Vec2 getNominalSize() const;
   vector<Texture> tiles;
@@ -213,7 +231,10 @@ class Renderer {
   stack<int> layerStack;
   int currentLayer = 0;
   array<vector<function<void()>>, 2> renderList;
-//  vector<Vertex> quads;
+  // Where each of the draw lists being recorded starts in renderList.
+  stack<array<int, 2>> drawListStarts;
+  SpriteBatch spriteBatch;
+  FrameStats lastFrameStats = {0, 0, milliseconds(0)};
   Vec2 mousePos;
   struct FontSet {
     int textFont;
@@ -221,6 +242,15 @@ class Renderer {
   };
   FontSet fonts;
   sth_stash* fontStash;
+  struct GlyphQuad {
+    SDL::GLuint texture;
+    Vec2 a, b, texA, texB;
+  };
+  typedef shared_ptr<const vector<GlyphQuad>> GlyphRun;
+  GlyphRun getGlyphRun(const string&, int size, FontId);
+  // Measuring text and looking up its glyphs is slow, so both are remembered for recently used strings.
+  HeapAllocated<CallCache<Vec2>> textSizeCache;
+  HeapAllocated<CallCache<GlyphRun>> glyphRunCache;
   void loadFonts(const string& fontPath, FontSet&);
   int getFont(Renderer::FontId);
   optional<thread::id> renderThreadId;
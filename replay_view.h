@@ -49,6 +49,15 @@ class ReplayView : public View {
       return readValue<bool>(LoggingToken::IS_CLOCK_STOPPED);
     }
 
+    virtual bool isTurboMode() override {
+      return readValue<bool>(LoggingToken::IS_TURBO_MODE);
+    }
+
+    virtual void stopTurboMode() override {
+      if (delegate)
+        delegate->stopTurboMode();
+    }
+
     virtual UserInput getAction() override {
       return readValue<UserInput>(LoggingToken::GET_ACTION);
     }
@@ -93,7 +93,7 @@ void Sectors::join(Vec2 pos1, int sector) {
   }
 }
 
-static DirtyTable<int> bfsTable(Level::getMaxBounds(), -1);
+static thread_local DirtyTable<int> bfsTable(Level::getMaxBounds(), -1);
 
 vector<Vec2> Sectors::getDisjoint(Vec2 pos) const {
   vector<queue<Vec2>> queues;
@@ -16,6 +16,7 @@
 #include "stdafx.h"
 
 #include "shortest_path.h"
+#include "trace.h"
 #include "level.h"
 #include "creature.h"
 #include "lasting_effect.h"
@@ -51,7 +52,7 @@ class DistanceTable {
   int counter = 1;
 };
 
-static DistanceTable distanceTable(Level::getMaxBounds());
+static thread_local DistanceTable distanceTable(Level::getMaxBounds());
 
 const int margin = 15;
 
@@ -78,6 +79,7 @@ bool inline operator < (const QueueElem& e1, const QueueElem& e2) {
 
 void ShortestPath::init(function<double(Vec2)> entryFun, function<double(Vec2)> lengthFun, Vec2 target,
     optional<Vec2> from, optional<int> limit) {
+  TRACE_ZONE("ShortestPath::init");
   reversed = false;
   distanceTable.clear();
   function<QueueElem(Vec2)> makeElem;
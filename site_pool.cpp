@@ -0,0 +1,141 @@
+#include "stdafx.h"
+#include "site_pool.h"
+#include "model_builder.h"
+#include "model.h"
+#include "campaign.h"
+#include "enemy_factory.h"
+#include "villain_type.h"
+#include "parse_game.h"
+#include <sys/types.h>
+#include "dirent.h"
+
+static const string suffix = ".site";
+
+SitePool::SitePool(const string& path, int version, Options* o)
+    : cachePath(path), saveVersion(version), options(o), stopRequested(false) {
+}
+
+SitePool::~SitePool() {
+  stop();
+}
+
+string SitePool::getPath(int seed) const {
+  return cachePath + "/" + toString(seed) + suffix;
+}
+
+static bool readHeader(const string& path, int& version, EnemyId& enemyId, VillainType& type, int& seed) {
+  try {
+    CompressedInput input(path.c_str());
+    input.getArchive() >> BOOST_SERIALIZATION_NVP(version) >> BOOST_SERIALIZATION_NVP(enemyId)
+        >> BOOST_SERIALIZATION_NVP(type) >> BOOST_SERIALIZATION_NVP(seed);
+  } catch (boost::archive::archive_exception& ex) {
+    return false;
+  }
+  return true;
+}
+
+void SitePool::scanCache() {
+  DIR* dir = opendir(cachePath.c_str());
+  CHECK(dir) << "Couldn't open " + cachePath;
+  vector<string> files;
+  while (dirent* ent = readdir(dir)) {
+    string path = cachePath + "/" + ent->d_name;
+    if (endsWith(path, suffix))
+      files.push_back(path);
+    else if (endsWith(path, suffix + ".tmp"))
+      remove(path.c_str());
+  }
+  closedir(dir);
+  for (auto& path : files) {
+    int version;
+    EnemyId enemyId;
+    VillainType type;
+    int seed;
+    // Sites from older versions of the game are thrown away.
+    if (readHeader(path, version, enemyId, type, seed) && version == saveVersion)
+      entries[{enemyId, type}].push_back(path);
+    else
+      remove(path.c_str());
+  }
+  scanned = true;
+}
+
+void SitePool::start(int sitesPerVillain) {
+  if (worker.joinable())
+    return;
+  std::unique_lock<std::mutex> lock(mutex);
+  if (!scanned)
+    scanCache();
+  vector<Key> missing;
+  for (auto playerType : {Campaign::KEEPER, Campaign::ADVENTURER})
+    for (auto& villain : Campaign::getPossibleVillains(playerType)) {
+      Key key {villain.enemyId, villain.type};
+      // Sokoban levels depend on the player's progress, so they have to be generated on demand.
+      if (villain.enemyId != EnemyId::SOKOBAN && !contains(missing, key))
+        for (int i = entries[key].size(); i < sitesPerVillain; ++i)
+          missing.push_back(key);
+    }
+  if (missing.empty())
+    return;
+  stopRequested = false;
+  int seed = Random.get(1000000000);
+  worker = makeThread([this, missing, seed] { fill(missing, seed); });
+}
+
+void SitePool::fill(vector<Key> missing, int seed) {
+  for (auto& key : missing) {
+    if (stopRequested)
+      return;
+    ++seed;
+    RandomGen random;
+    random.init(seed);
+    PModel model = ModelBuilder(nullptr, random, options, nullptr)
+        .campaignSiteModel("Campaign enemy site", key.first, key.second);
+    string path = getPath(seed);
+    string tmpPath = path + ".tmp";
+    {
+      CompressedOutput out(tmpPath.c_str());
+      out.getArchive() << BOOST_SERIALIZATION_NVP(saveVersion) << BOOST_SERIALIZATION_NVP(key.first)
+          << BOOST_SERIALIZATION_NVP(key.second) << BOOST_SERIALIZATION_NVP(seed);
+      Serialization::registerTypes(out.getArchive(), saveVersion);
+      out.getArchive() << BOOST_SERIALIZATION_NVP(model);
+    }
+    // Renamed only when complete, so that a crash or exit doesn't leave a truncated site in the pool.
+    rename(tmpPath.c_str(), path.c_str());
+    std::unique_lock<std::mutex> lock(mutex);
+    entries[key].push_back(path);
+  }
+}
+
+void SitePool::stop() {
+  stopRequested = true;
+  if (worker.joinable())
+    worker.join();
+}
+
+PModel SitePool::take(EnemyId enemyId, VillainType type) {
+  std::unique_lock<std::mutex> lock(mutex);
+  auto& paths = entries[{enemyId, type}];
+  while (!paths.empty()) {
+    string path = paths.back();
+    paths.pop_back();
+    PModel model;
+    try {
+      CompressedInput input(path.c_str());
+      int version;
+      Key key;
+      int seed;
+      input.getArchive() >> BOOST_SERIALIZATION_NVP(version) >> BOOST_SERIALIZATION_NVP(key.first)
+          >> BOOST_SERIALIZATION_NVP(key.second) >> BOOST_SERIALIZATION_NVP(seed);
+      CHECK(key == Key(enemyId, type));
+      Serialization::registerTypes(input.getArchive(), version);
+      input.getArchive() >> BOOST_SERIALIZATION_NVP(model);
+      INFO << "Using pre-generated site " << EnumInfo<EnemyId>::getString(enemyId) << " seed " << seed;
+    } catch (boost::archive::archive_exception& ex) {
+    }
+    remove(path.c_str());
+    if (model)
+      return model;
+  }
+  return nullptr;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "util.h"
+
+class Options;
+enum class EnemyId;
+enum class VillainType;
+
+// Generates campaign enemy sites on a background thread while the player is in the menus,
+// and keeps them in a cache directory, so that starting a campaign doesn't have to wait for them.
+class SitePool {
+  public:
+  SitePool(const string& cachePath, int saveVersion, Options*);
+  ~SitePool();
+
+  // Fills the pool up to sitesPerVillain entries for every villain that can appear in a campaign.
+  // Does nothing if the worker is already running.
+  void start(int sitesPerVillain);
+
+  // Waits for the site that is currently being generated and stops the worker.
+  void stop();
+
+  // Returns a pre-generated site and removes it from the pool, or null if there is none.
+  // Must not be called while the worker is running.
+  PModel take(EnemyId, VillainType);
+
+  private:
+  typedef pair<EnemyId, VillainType> Key;
+  void scanCache();
+  void fill(vector<Key> missing, int seed);
+  string getPath(int seed) const;
+
+  string cachePath;
+  int saveVersion;
+  Options* options;
+  map<Key, vector<string>> entries;
+  bool scanned = false;
+  thread worker;
+  atomic<bool> stopRequested;
+  std::mutex mutex;
+};
@@ -32,7 +32,10 @@ static int getTableNum(const string& path) {
   return ret;
 }
 
+static std::mutex stateMutex;
+
 Table<char> SokobanInput::getNext() {
+  std::unique_lock<std::mutex> lock(stateMutex);
   ifstream input(levelsPath.c_str());
   CHECK(input) << "Failed to load sokoban data from " << levelsPath;
   vector<Table<char>> rest;
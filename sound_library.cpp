@@ -6,7 +6,8 @@
 
 #include "audio_device.h"
 
-SoundLibrary::SoundLibrary(Options* options, AudioDevice& audio, const string& path) : audioDevice(audio) {
+SoundLibrary::SoundLibrary(Options* options, AudioDevice& audio, const string& path) : audioDevice(audio),
+    loader([this] { loadSounds(); }) {
 #ifdef DISABLE_SFX
   on = false;
 #else
@@ -17,22 +18,86 @@ SoundLibrary::SoundLibrary(Options* options, AudioDevice& audio, const string& p
     addSounds(id, path + "/" + toLower(EnumInfo<SoundId>::getString(id)));
 }
 
+SoundLibrary::~SoundLibrary() {
+  loader.finishAndWait();
+}
+
 void SoundLibrary::addSounds(SoundId id, const string& path) {
   DIR* dir = opendir(path.c_str());
   CHECK(dir) << path;
-  vector<string> files;
   while (dirent* ent = readdir(dir)) {
     string name(ent->d_name);
     if (endsWith(name, ".ogg"))
-      sounds[id].emplace_back((path + "/" + name).c_str());
+      sounds[id].push_back(path + "/" + name);
+  }
+  closedir(dir);
+}
+
+void SoundLibrary::loadSounds() {
+  if (auto path = toLoad.popAsync())
+    loaded.push({*path, make_shared<DecodedSound>(path->c_str())});
+  else
+    sleep_for(milliseconds(10));
+}
+
+// Decoded sound data kept in OpenAL buffers. Sounds that were evicted are decoded again when needed.
+const int maxCacheSize = 32 * 1024 * 1024;
+
+void SoundLibrary::addLoadedSounds() {
+  while (auto sound = loaded.popAsync()) {
+    requested.erase(sound->first);
+    int size = sound->second->getSize();
+    cache[sound->first] = {unique_ptr<SoundBuffer>(new SoundBuffer(*sound->second)), size, ++useCounter};
+    cacheSize += size;
+  }
+  shrinkCache();
+}
+
+void SoundLibrary::shrinkCache() {
+  while (cacheSize > maxCacheSize) {
+    optional<map<string, CachedSound>::iterator> lru;
+    for (auto it = cache.begin(); it != cache.end(); ++it)
+      if ((!lru || it->second.lastUsed < (*lru)->second.lastUsed) && audioDevice.releaseBuffer(*it->second.buffer))
+        lru = it;
+    if (!lru)
+      break;
+    cacheSize -= (*lru)->second.size;
+    cache.erase(*lru);
+  }
+}
+
+SoundBuffer* SoundLibrary::getBuffer(const string& path) {
+  auto it = cache.find(path);
+  if (it == cache.end())
+    return nullptr;
+  it->second.lastUsed = ++useCounter;
+  return it->second.buffer.get();
+}
+
+void SoundLibrary::requestLoad(const string& path) {
+  if (!requested.count(path)) {
+    requested.insert(path);
+    toLoad.push(path);
   }
 }
 
 void SoundLibrary::playSound(const Sound& s) {
   if (!on)
     return;
-  if (int numSounds = sounds[s.getId()].size()) {
+  addLoadedSounds();
+  const vector<string>& paths = sounds[s.getId()];
+  if (int numSounds = paths.size()) {
     int ind = Random.get(numSounds);
-    audioDevice.play(sounds[s.getId()][ind], 1.0, s.getPitch());
+    if (auto buffer = getBuffer(paths[ind]))
+      audioDevice.play(*buffer, 1.0, s.getPitch());
+    else {
+      requestLoad(paths[ind]);
+      // Until the chosen variant is decoded play any other variant of this sound that's ready.
+      for (auto& path : paths)
+        if (auto buffer = getBuffer(path)) {
+          audioDevice.play(*buffer, 1.0, s.getPitch());
+          break;
+        }
+    }
   }
 }
@@ -6,15 +6,34 @@
 class Options;
 class AudioDevice;
 class SoundBuffer;
+class DecodedSound;
 
 class SoundLibrary {
   public:
   SoundLibrary(Options*, AudioDevice&, const string& path);
+  ~SoundLibrary();
   void playSound(const Sound&);
 
   private:
   void addSounds(SoundId, const string& path);
-  EnumMap<SoundId, vector<SoundBuffer>> sounds;
+  SoundBuffer* getBuffer(const string& path);
+  void requestLoad(const string& path);
+  void loadSounds();
+  void addLoadedSounds();
+  void shrinkCache();
+  EnumMap<SoundId, vector<string>> sounds;
+  struct CachedSound {
+    unique_ptr<SoundBuffer> buffer;
+    int size;
+    int lastUsed;
+  };
+  map<string, CachedSound> cache;
+  int cacheSize = 0;
+  int useCounter = 0;
+  set<string> requested;
+  SyncQueue<string> toLoad;
+  SyncQueue<pair<string, shared_ptr<DecodedSound>>> loaded;
   bool on;
   AudioDevice& audioDevice;
+  AsyncLoop loader;
 };
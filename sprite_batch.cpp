@@ -0,0 +1,110 @@
+#include "stdafx.h"
+#include "sprite_batch.h"
+
+namespace {
+
+class OpenGlBackend : public SpriteBatch::Backend {
+  public:
+  virtual void draw(optional<SDL::GLuint> texture, const vector<float>& vertices,
+      const vector<float>& texCoords, const vector<Uint8>& colors) override {
+    if (texture) {
+      SDL::glBindTexture(GL_TEXTURE_2D, *texture);
+      SDL::glEnable(GL_TEXTURE_2D);
+      SDL::glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+      SDL::glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
+    } else
+      SDL::glDisable(GL_TEXTURE_2D);
+    SDL::glEnableClientState(GL_VERTEX_ARRAY);
+    SDL::glEnableClientState(GL_COLOR_ARRAY);
+    SDL::glVertexPointer(2, GL_FLOAT, 0, vertices.data());
+    SDL::glColorPointer(4, GL_UNSIGNED_BYTE, 0, colors.data());
+    SDL::glDrawArrays(GL_QUADS, 0, vertices.size() / 2);
+    SDL::glDisableClientState(GL_COLOR_ARRAY);
+    SDL::glDisableClientState(GL_VERTEX_ARRAY);
+    if (texture) {
+      SDL::glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+      SDL::glDisable(GL_TEXTURE_2D);
+    }
+    CHECK(SDL::glGetError() == GL_NO_ERROR);
+  }
+};
+
+}
+
+unique_ptr<SpriteBatch::Backend> SpriteBatch::openGlBackend() {
+  return unique_ptr<Backend>(new OpenGlBackend());
+}
+
+void SpriteBatch::RecordingBackend::draw(optional<SDL::GLuint> texture, const vector<float>& vertices,
+    const vector<float>&, const vector<Uint8>&) {
+  commands.push_back({texture, int(vertices.size() / 8)});
+}
+
+const vector<SpriteBatch::DrawCommand>& SpriteBatch::RecordingBackend::getCommands() const {
+  return commands;
+}
+
+void SpriteBatch::RecordingBackend::clear() {
+  commands.clear();
+}
+
+SpriteBatch::SpriteBatch(unique_ptr<Backend> b) : backend(std::move(b)) {
+}
+
+void SpriteBatch::setTexture(optional<SDL::GLuint> t) {
+  if (t != texture) {
+    flush();
+    texture = t;
+  }
+}
+
+void SpriteBatch::addVertex(float x, float y, SDL::SDL_Color color) {
+  vertices.push_back(x);
+  vertices.push_back(y);
+  colors.push_back(color.r);
+  colors.push_back(color.g);
+  colors.push_back(color.b);
+  colors.push_back(color.a);
+}
+
+void SpriteBatch::addQuad(Vec2 a, Vec2 b, SDL::SDL_Color color) {
+  setTexture(none);
+  addVertex(a.x, a.y, color);
+  addVertex(b.x, a.y, color);
+  addVertex(b.x, b.y, color);
+  addVertex(a.x, b.y, color);
+  ++stats.quads;
+}
+
+void SpriteBatch::addQuad(SDL::GLuint tex, Vec2 texSize, Vec2 a, Vec2 b, Vec2 p, Vec2 k, SDL::SDL_Color color) {
+  setTexture(tex);
+  float px = float(p.x) / texSize.x;
+  float py = float(p.y) / texSize.y;
+  float kx = float(k.x) / texSize.x;
+  float ky = float(k.y) / texSize.y;
+  for (float coord : {px, py, kx, py, kx, ky, px, ky})
+    texCoords.push_back(coord);
+  addVertex(a.x, a.y, color);
+  addVertex(b.x, a.y, color);
+  addVertex(b.x, b.y, color);
+  addVertex(a.x, b.y, color);
+  ++stats.quads;
+}
+
+void SpriteBatch::flush() {
+  if (!vertices.empty()) {
+    backend->draw(texture, vertices, texCoords, colors);
+    ++stats.drawCalls;
+    vertices.clear();
+    texCoords.clear();
+    colors.clear();
+  }
+}
+
+const SpriteBatch::Stats& SpriteBatch::getStats() const {
+  return stats;
+}
+
+void SpriteBatch::resetStats() {
+  stats = {0, 0};
+}
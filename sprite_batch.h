@@ -0,0 +1,58 @@
+#pragma once
+
+#include "util.h"
+#include "sdl.h"
+
+// Collects quads and submits consecutive quads that share a texture with a single draw call.
+// Submission order is preserved, so overlapping sprites are still painted in the order they were added.
+class SpriteBatch {
+  public:
+  class Backend {
+    public:
+    virtual void draw(optional<SDL::GLuint> texture, const vector<float>& vertices,
+        const vector<float>& texCoords, const vector<Uint8>& colors) = 0;
+    virtual ~Backend() {}
+  };
+
+  static unique_ptr<Backend> openGlBackend();
+
+  struct DrawCommand {
+    optional<SDL::GLuint> texture;
+    int numQuads;
+  };
+
+  // Doesn't touch OpenGL. Used to count draw calls in tests and headless benchmarks.
+  class RecordingBackend : public Backend {
+    public:
+    virtual void draw(optional<SDL::GLuint> texture, const vector<float>& vertices,
+        const vector<float>& texCoords, const vector<Uint8>& colors) override;
+    const vector<DrawCommand>& getCommands() const;
+    void clear();
+
+    private:
+    vector<DrawCommand> commands;
+  };
+
+  SpriteBatch(unique_ptr<Backend>);
+
+  void addQuad(Vec2 a, Vec2 b, SDL::SDL_Color);
+  void addQuad(SDL::GLuint texture, Vec2 texSize, Vec2 a, Vec2 b, Vec2 texA, Vec2 texB, SDL::SDL_Color);
+  void flush();
+
+  struct Stats {
+    int drawCalls;
+    int quads;
+  };
+  const Stats& getStats() const;
+  void resetStats();
+
+  private:
+  void addVertex(float x, float y, SDL::SDL_Color);
+  void setTexture(optional<SDL::GLuint>);
+  unique_ptr<Backend> backend;
+  optional<SDL::GLuint> texture;
+  vector<float> vertices;
+  vector<float> texCoords;
+  vector<Uint8> colors;
+  Stats stats = {0, 0};
+};
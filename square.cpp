@@ -107,12 +107,15 @@ void Square::onAddedToLevel(Position pos) const {
 
 void Square::tick(Position pos) {
   setDirty(pos);
-  if (!inventory->isEmpty())
+  if (!inventory->isEmpty()) {
     for (Item* item : getInventory().getItems()) {
       item->tick(pos);
       if (item->isDiscarded())
         getInventory().removeItem(item);
     }
+    // Dropping items wakes the square up, so new items are merged into the existing stacks here.
+    getInventory().mergeStacks();
+  }
   poisonGas->tick(pos);
   if (creature && poisonGas->getAmount() > 0.2) {
     creature->poisonWithGas(min(1.0, poisonGas->getAmount()));
@@ -121,6 +124,19 @@ void Square::tick(Position pos) {
     t->tick();
 }
 
+bool Square::needsTick() const {
+  if (poisonGas->getAmount() > 0)
+    return true;
+  for (const PTrigger& t : triggers)
+    if (t->needsTick())
+      return true;
+  if (!inventory->isEmpty())
+    for (Item* item : getInventory().getItems())
+      if (item->needsTick())
+        return true;
+  return false;
+}
+
 bool Square::itemLands(vector<Item*> item, const Attack& attack) const {
   if (creature) {
     if (!creature->dodgeAttack(attack))
@@ -306,6 +322,11 @@ PItem Square::removeItem(Position pos, Item* it) {
   return getInventory().removeItem(it);
 }
 
+PItem Square::removeItem(Position pos, Item* it, int count) {
+  setDirty(pos);
+  return getInventory().removeItem(it, count);
+}
+
 vector<PItem> Square::removeItems(Position pos, vector<Item*> it) {
   setDirty(pos);
   return getInventory().removeItems(it);
@@ -122,8 +122,10 @@ class Square : public Renderable {
   //@}
 
   /** Triggers all time-dependent processes like burning. Calls tick() for items if present.
-      For this method to be called, the square coordinates must be added with Level::addTickingSquare().*/
+      For this method to be called, the square coordinates must be added with Level::addTickingSquare().
+      The level stops ticking the square once needsTick() returns false.*/
   void tick(Position);
+  bool needsTick() const;
 
   optional<ViewObject> extractBackground() const;
   void getViewIndex(ViewIndex&, const Creature* viewer) const;
@@ -134,6 +136,7 @@ class Square : public Renderable {
   vector<Item*> getItems(function<bool (Item*)> predicate) const;
   const vector<Item*>& getItems(ItemIndex) const;
   PItem removeItem(Position, Item*);
+  PItem removeItem(Position, Item*, int count);
   vector<PItem> removeItems(Position, vector<Item*>);
 
   void forbidMovementForTribe(Position, TribeId);
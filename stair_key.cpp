@@ -1,7 +1,7 @@
 #include "stdafx.h"
 #include "stair_key.h"
 
-int StairKey::numKeys = 3;
+atomic<int> StairKey::numKeys(3);
 
 StairKey StairKey::getNew() {
   return numKeys++;
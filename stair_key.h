@@ -17,7 +17,7 @@ class StairKey {
   private:
   StairKey(int key);
   int SERIAL(key);
-  static int numKeys;
+  static atomic<int> numKeys;
 };
 
 namespace std {
@@ -2,6 +2,7 @@
 #include "territory.h"
 #include "position.h"
 #include "movement_type.h"
+#include "level.h"
 
 template <class Archive>
 void Territory::serialize(Archive& ar, const unsigned int version) {
@@ -10,16 +11,129 @@ void Territory::serialize(Archive& ar, const unsigned int version) {
 
 SERIALIZABLE(Territory);
 
-void Territory::clearCache() {
+// The largest radius that can be passed to getExtended.
+static const int maxRadius = 20;
+static const int infinity = 1000000;
+// Room left around the territory when a field is allocated, so that it doesn't have to be reallocated
+// every time the territory grows by one square.
+static const int fieldSlack = 10;
+
+Territory::DistanceField::DistanceField(Level* l, Rectangle in) : level(l), inner(in),
+    distance(inner.minusMargin(-maxRadius).intersection(level->getBounds()), infinity),
+    inTerritory(distance.getBounds(), false), reachedIndex(distance.getBounds(), -1), numMovementChanges(0) {
+}
+
+void Territory::clearCache() const {
   extendedCache.clear();
   extendedCache2.clear();
 }
 
+void Territory::setDistance(DistanceField& field, Vec2 v, int dist) const {
+  int& current = field.distance[v];
+  if (current == infinity && dist != infinity) {
+    field.reachedIndex[v] = field.reached.size();
+    field.reached.push_back(v);
+  } else if (current != infinity && dist == infinity) {
+    int index = field.reachedIndex[v];
+    field.reachedIndex[field.reached.back()] = index;
+    field.reached[index] = field.reached.back();
+    field.reached.pop_back();
+    field.reachedIndex[v] = -1;
+  }
+  current = dist;
+}
+
+// Recomputes the distances inside area, assuming the ones outside are correct. A change of a single square
+// only affects the distances within maxRadius of it, so it's enough to recompute that area.
+void Territory::recompute(DistanceField& field, Rectangle area) const {
+  area = area.intersection(field.distance.getBounds());
+  vector<vector<Vec2>> queue(maxRadius + 1);
+  for (Vec2 v : area)
+    if (field.inTerritory[v]) {
+      setDistance(field, v, 1);
+      queue[1].push_back(v);
+    } else
+      setDistance(field, v, infinity);
+  for (Vec2 v : area.minusMargin(-1).intersection(field.distance.getBounds()))
+    if (!v.inRectangle(area) && field.distance[v] < maxRadius)
+      queue[field.distance[v]].push_back(v);
+  for (int dist = 1; dist < maxRadius; ++dist)
+    for (int i = 0; i < queue[dist].size(); ++i) {
+      Vec2 pos = queue[dist][i];
+      for (Vec2 v : pos.neighbors8())
+        if (v.inRectangle(area) && field.distance[v] > dist + 1 && !field.inTerritory[v] &&
+            Position(v, field.level).canEnterEmpty({MovementTrait::WALK})) {
+          setDistance(field, v, dist + 1);
+          queue[dist + 1].push_back(v);
+        }
+    }
+  clearCache();
+  ++extendedVersion;
+}
+
+void Territory::buildField(Level* level) const {
+  fields.erase(level->getUniqueId());
+  vector<Vec2> squares;
+  for (Position pos : allSquaresVec)
+    if (pos.isSameLevel(level))
+      squares.push_back(pos.getCoord());
+  clearCache();
+  ++extendedVersion;
+  if (squares.empty())
+    return;
+  auto& field = fields.emplace(level->getUniqueId(),
+      DistanceField(level, Rectangle::boundingBox(squares).minusMargin(-fieldSlack))).first->second;
+  field.numMovementChanges = level->getNumMovementChanges();
+  for (Vec2 v : squares)
+    field.inTerritory[v] = true;
+  recompute(field, field.distance.getBounds());
+}
+
+void Territory::updateFields() const {
+  if (!fieldsInitialized) {
+    set<Level*> levels;
+    for (Position pos : allSquaresVec)
+      levels.insert(pos.getLevel());
+    for (Level* level : levels)
+      buildField(level);
+    fieldsInitialized = true;
+  }
+  vector<Level*> outdated;
+  for (auto& elem : fields) {
+    auto& field = elem.second;
+    if (field.numMovementChanges == field.level->getNumMovementChanges())
+      continue;
+    vector<Vec2> changes;
+    if (!field.level->getMovementChanges(field.numMovementChanges, changes))
+      outdated.push_back(field.level);
+    // Recomputing around each change only pays off if there are few of them.
+    else if (changes.size() > 20)
+      outdated.push_back(field.level);
+    else {
+      field.numMovementChanges = field.level->getNumMovementChanges();
+      for (Vec2 v : changes)
+        if (v.inRectangle(field.distance.getBounds()))
+          recompute(field, Rectangle::centered(v, maxRadius));
+    }
+  }
+  for (Level* level : outdated)
+    buildField(level);
+}
+
 void Territory::insert(Position pos) {
   if (!allSquares.count(pos)) {
     allSquaresVec.push_back(pos);
     allSquares.insert(pos);
     clearCache();
+    if (fieldsInitialized) {
+      auto field = fields.find(pos.getLevel()->getUniqueId());
+      if (field == fields.end() || !pos.getCoord().inRectangle(field->second.inner))
+        buildField(pos.getLevel());
+      else {
+        field->second.inTerritory[pos.getCoord()] = true;
+        recompute(field->second, Rectangle::centered(pos.getCoord(), maxRadius));
+      }
+    }
   }
 }
 
@@ -27,8 +141,14 @@ void Territory::remove(Position pos) {
   removeElement(allSquaresVec, pos);
   allSquares.erase(pos);
   clearCache();
+  if (fieldsInitialized) {
+    auto field = fields.find(pos.getLevel()->getUniqueId());
+    CHECK(field != fields.end());
+    field->second.inTerritory[pos.getCoord()] = false;
+    recompute(field->second, Rectangle::centered(pos.getCoord(), maxRadius));
+  }
 }
-  
+
 bool Territory::contains(Position pos) const {
   return allSquares.count(pos);
 }
@@ -37,28 +157,52 @@ const vector<Position>& Territory::getAll() const {
   return allSquaresVec;
 }
 
-vector<Position> Territory::calculateExtended(int minRadius, int maxRadius) const {
-  map<Position, int> extendedTiles;
-  vector<Position> extendedQueue;
-  for (Position pos : allSquaresVec) {
-    if (!extendedTiles.count(pos))  {
-      extendedTiles[pos] = 1;
-      extendedQueue.push_back(pos);
-    }
+void Territory::forEachExtended(int max, function<void(Position)> fun) const {
+  CHECK(max <= maxRadius);
+  updateFields();
+  for (auto& elem : fields) {
+    auto& field = elem.second;
+    for (Vec2 v : field.reached)
+      if (field.distance[v] <= max)
+        fun(Position(v, field.level));
   }
-  for (int i = 0; i < extendedQueue.size(); ++i) {
-    Position pos = extendedQueue[i];
-    for (Position v : pos.neighbors8())
-      if (!contains(v) && !extendedTiles.count(v) 
-          && v.canEnterEmpty({MovementTrait::WALK})) {
-        int a = extendedTiles[v] = extendedTiles[pos] + 1;
-        if (a < maxRadius)
-          extendedQueue.push_back(v);
-      }
+}
+
+bool Territory::isInExtended(Position pos, int max) const {
+  CHECK(max <= maxRadius);
+  updateFields();
+  if (!pos.isValid())
+    return false;
+  auto field = fields.find(pos.getLevel()->getUniqueId());
+  return field != fields.end() && pos.getCoord().inRectangle(field->second.distance.getBounds()) &&
+      field->second.distance[pos.getCoord()] <= max;
+}
+
+vector<pair<Level*, Rectangle>> Territory::getExtendedBounds() const {
+  updateFields();
+  vector<pair<Level*, Rectangle>> ret;
+  for (auto& elem : fields)
+    ret.push_back({elem.second.level, elem.second.distance.getBounds()});
+  return ret;
+}
+
+int Territory::getExtendedVersion() const {
+  updateFields();
+  return extendedVersion;
+}
+
+vector<Position> Territory::calculateExtended(int minRadius, int max) const {
+  CHECK(max <= maxRadius);
+  vector<Position> ret;
+  for (auto& elem : fields) {
+    auto& field = elem.second;
+    for (Vec2 v : field.reached) {
+      int dist = field.distance[v];
+      if (dist >= minRadius && dist <= max)
+        ret.push_back(Position(v, field.level));
+    }
   }
-  if (minRadius > 0)
-    return filter(extendedQueue, [&] (const Position& v) { return extendedTiles.at(v) >= minRadius; });
-  return extendedQueue;
+  return ret;
 }
 
 const vector<Position>& Territory::getStandardExtended() const {
@@ -66,12 +210,14 @@ const vector<Position>& Territory::getStandardExtended() const {
 }
 
 const vector<Position>& Territory::getExtended(int min, int max) const {
+  updateFields();
   if (!extendedCache.count(make_pair(min, max)))
     extendedCache[make_pair(min, max)] = calculateExtended(min, max);
   return extendedCache.at(make_pair(min, max));
 }
 
 const vector<Position>& Territory::getExtended(int max) const {
+  updateFields();
   if (!extendedCache2.count(max))
     extendedCache2[max] = calculateExtended(0, max);
   return extendedCache2.at(max);
@@ -80,4 +226,3 @@ const vector<Position>& Territory::getExtended(int max) const {
 bool Territory::isEmpty() const {
   return allSquaresVec.empty();
 }
-
@@ -14,16 +14,44 @@ class Territory {
   const vector<Position>& getStandardExtended() const;
   bool isEmpty() const;
 
+  // Calls fun for every position that getExtended(max) would return, without copying them.
+  void forEachExtended(int max, function<void(Position)> fun) const;
+  bool isInExtended(Position, int max) const;
+  // Areas that contain the whole extended territory, one for each level.
+  vector<pair<Level*, Rectangle>> getExtendedBounds() const;
+  // Changes every time the extended territory might have changed.
+  int getExtendedVersion() const;
+
   template <class Archive>
   void serialize(Archive& ar, const unsigned int version);
 
   private:
-  void clearCache();
-  vector<Position> calculateExtended(int minRadius, int maxRadius) const;
+  void clearCache() const;
+
+  // Walking distance from the territory, where territory squares are at distance 1.
+  // Kept up to date incrementally when squares are claimed or lost, or their passability changes.
+  struct DistanceField {
+    DistanceField(Level*, Rectangle inner);
+    Level* level;
+    // Territory squares must lie within inner. The distances are stored for the surrounding area.
+    Rectangle inner;
+    Table<int> distance;
+    Table<bool> inTerritory;
+    Table<int> reachedIndex;
+    vector<Vec2> reached;
+    long long numMovementChanges;
+  };
+  void updateFields() const;
+  void buildField(Level*) const;
+  void recompute(DistanceField&, Rectangle area) const;
+  void setDistance(DistanceField&, Vec2, int) const;
+  vector<Position> calculateExtended(int minRadius, int max) const;
   set<Position> SERIAL(allSquares);
   vector<Position> SERIAL(allSquaresVec);
+  mutable map<LevelId, DistanceField> fields;
+  mutable bool fieldsInitialized = false;
+  mutable int extendedVersion = 0;
   mutable map<pair<int, int>, vector<Position>> extendedCache;
   mutable map<int, vector<Position>> extendedCache2;
 };
 
-
@@ -28,7 +28,11 @@
 #include "item.h"
 #include "modifier_type.h"
 #include "body.h"
+#include "triple_buffer.h"
+#include "trace.h"
 #include "call_cache.h"
+#include "worldgen_profiler.h"
+#include "sprite_batch.h"
 
 
 class Test {
@@ -775,6 +779,155 @@ class Test {
     CHECKEQ(cache.getSize(), 3);
   }
 
+  struct CollidingKey {
+    int value;
+    size_t getHash() const {
+      return 7;
+    }
+    bool operator == (const CollidingKey& other) const {
+      return value == other.value;
+    }
+  };
+
+  void testCacheCollisions() {
+    CallCache<int> cache(3);
+    int calls = 0;
+    auto gen = [&calls] (const CollidingKey& key) { ++calls; return key.value; };
+    for (int i : Range(10))
+      for (int j : Range(3))
+        CHECKEQ(cache.get(gen, 123, CollidingKey{j}), j);
+    CHECKEQ(calls, 3);
+    CHECKEQ(cache.get(gen, 123, CollidingKey{3}), 3);
+    CHECKEQ(cache.getSize(), 3);
+    CHECKEQ(calls, 4);
+    CHECK(!cache.contains(123, CollidingKey{0}));
+    CHECK(cache.contains(123, CollidingKey{1}));
+    CHECK(!cache.contains(124, CollidingKey{1}));
+    for (int j : Range(1, 4))
+      CHECKEQ(cache.get(gen, 123, CollidingKey{j}), j);
+    CHECKEQ(calls, 4);
+    CHECKEQ(cache.getStats().hits, 30);
+    CHECKEQ(cache.getStats().misses, 4);
+  }
+
+  void testSpriteBatch() {
+    auto backend = new SpriteBatch::RecordingBackend();
+    SpriteBatch batch((unique_ptr<SpriteBatch::Backend>(backend)));
+    SDL::SDL_Color white {255, 255, 255, 255};
+    for (int i : Range(100))
+      batch.addQuad(1, Vec2(100, 100), Vec2(i, 0), Vec2(i + 1, 1), Vec2(0, 0), Vec2(1, 1), white);
+    batch.addQuad(Vec2(0, 0), Vec2(5, 5), white);
+    batch.addQuad(Vec2(0, 0), Vec2(5, 5), white);
+    batch.addQuad(2, Vec2(100, 100), Vec2(0, 0), Vec2(1, 1), Vec2(0, 0), Vec2(1, 1), white);
+    batch.addQuad(1, Vec2(100, 100), Vec2(0, 0), Vec2(1, 1), Vec2(0, 0), Vec2(1, 1), white);
+    CHECKEQ(backend->getCommands().size(), 3);
+    batch.flush();
+    batch.flush();
+    auto& commands = backend->getCommands();
+    CHECKEQ(commands.size(), 4);
+    CHECK(commands[0].texture == 1u && commands[0].numQuads == 100);
+    CHECK(!commands[1].texture && commands[1].numQuads == 2);
+    CHECK(commands[2].texture == 2u && commands[2].numQuads == 1);
+    CHECK(commands[3].texture == 1u && commands[3].numQuads == 1);
+    CHECKEQ(batch.getStats().drawCalls, 4);
+    CHECKEQ(batch.getStats().quads, 104);
+  }
+
+  void testDisjointSets() {
+    DisjointSets sets(6);
+    sets.join(0, 1);
+    sets.join(2, 3);
+    sets.join(1, 1);
+    CHECK(sets.same(0, 1));
+    CHECK(!sets.same(1, 2));
+    sets.join(3, 0);
+    CHECK(sets.same({0, 1, 2, 3}));
+    CHECK(!sets.same(4, 5));
+    CHECK(sets.getSet(2) == sets.getSet(1));
+    CHECK(sets.getSet(4) != sets.getSet(5));
+  }
+
+  void testWorldgenProfiler() {
+    WorldgenProfiler profiler;
+    WorldgenProfiler::Scope scope(profiler);
+    CHECK(WorldgenProfiler::getCurrent() == &profiler);
+    for (int i : Range(3))
+      try {
+        profiler.measure("queue", [&] {
+          profiler.measure("rooms", [] {});
+          profiler.measure("connector", [i] { if (i > 0) throw LevelGenException(); });
+        });
+      } catch (LevelGenException) {}
+    std::stringstream out;
+    profiler.writeJson(out);
+    string json = out.str();
+    auto getCount = [&] (const string& node, const string& field) {
+      auto pos = json.find("\"" + field + "\"", json.find("\"name\": \"" + node + "\""));
+      return fromString<int>(json.substr(json.find(':', pos) + 2, json.find(',', pos) - json.find(':', pos) - 2));
+    };
+    CHECKEQ(getCount("queue", "calls"), 3);
+    CHECKEQ(getCount("queue", "failures"), 2);
+    CHECKEQ(getCount("queue", "ownFailures"), 0);
+    CHECKEQ(getCount("rooms", "calls"), 3);
+    CHECKEQ(getCount("rooms", "failures"), 0);
+    CHECKEQ(getCount("connector", "failures"), 2);
+    CHECKEQ(getCount("connector", "ownFailures"), 2);
+  }
+
+  void testTripleBuffer() {
+    TripleBuffer<int> buffer;
+    CHECK(buffer.wasConsumed());
+    CHECK(!buffer.consume());
+    buffer.getBack() = 1;
+    buffer.publish();
+    CHECK(!buffer.wasConsumed());
+    buffer.getBack() = 2;
+    buffer.publish();
+    CHECKEQ(*buffer.consume(), 2);
+    CHECK(buffer.wasConsumed());
+    CHECK(!buffer.consume());
+    const int numValues = 100000;
+    thread producer([&] {
+      for (int i = 3; i <= numValues; ++i) {
+        buffer.getBack() = i;
+        buffer.publish();
+      }
+    });
+    int last = 2;
+    while (last < numValues)
+      if (int* value = buffer.consume()) {
+        CHECK(*value > last);
+        last = *value;
+      }
+    producer.join();
+  }
+
+  void testTracer() {
+    std::stringstream out;
+    Tracer::start(out);
+    CHECK(Tracer::isEnabled());
+    {
+      Tracer::Zone zone("outer");
+      Tracer::Zone zone2("inner");
+    }
+    thread t([] { Tracer::setThreadName("other"); Tracer::Zone zone("other zone"); });
+    t.join();
+    Tracer::stop();
+    CHECK(!Tracer::isEnabled());
+    { Tracer::Zone zone("after stop"); }
+    string json = out.str();
+    CHECK(json.front() == '[');
+    CHECK(json.find("\n]") != string::npos);
+    auto getTid = [&] (const string& name) {
+      auto pos = json.find("\"tid\": ", json.find("\"name\": \"" + name + "\""));
+      return fromString<int>(json.substr(pos + 7, json.find(',', pos) - pos - 7));
+    };
+    CHECKEQ(getTid("outer"), getTid("inner"));
+    CHECK(getTid("outer") != getTid("other zone"));
+    CHECK(json.find("\"name\": \"other\"") != string::npos);
+    CHECK(json.find("after stop") == string::npos);
+  }
+
 };
 
 void testAll() {
@@ -824,5 +977,11 @@ void testAll() {
   Test().testContainerRangeMapConst();
   Test().testCacheTemplate();
   Test().testCacheTemplate2();
+  Test().testCacheCollisions();
+  Test().testSpriteBatch();
+  Test().testDisjointSets();
+  Test().testWorldgenProfiler();
+  Test().testTripleBuffer();
+  Test().testTracer();
   INFO << "-----===== OK =====-----";
 }
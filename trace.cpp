@@ -0,0 +1,119 @@
+#include "stdafx.h"
+#include "trace.h"
+
+using namespace std::chrono;
+
+namespace {
+
+struct Event {
+  const char* name;
+  long long start;
+  long long duration;
+};
+
+// Zones are collected per thread and written out in batches, so that threads rarely wait for each other.
+struct ThreadBuffer {
+  int id;
+  std::mutex mutex;
+  vector<Event> events;
+};
+
+}
+
+// Guards everything below and writing to the output.
+static std::mutex outputMutex;
+static std::ostream* output = nullptr;
+static atomic<bool> enabled(false);
+static steady_clock::time_point startTime;
+static vector<unique_ptr<ThreadBuffer>> buffers;
+static thread_local ThreadBuffer* threadBuffer = nullptr;
+static const int bufferSize = 10000;
+
+static long long getMicros() {
+  return duration_cast<microseconds>(steady_clock::now() - startTime).count();
+}
+
+static void writeThreadName(int id, const string& name) {
+  *output << ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << id
+      << ", \"args\": {\"name\": \"" << name << "\"}}";
+}
+
+static ThreadBuffer& getThreadBuffer() {
+  if (!threadBuffer) {
+    std::unique_lock<std::mutex> lock(outputMutex);
+    buffers.emplace_back(new ThreadBuffer());
+    threadBuffer = buffers.back().get();
+    threadBuffer->id = buffers.size();
+    threadBuffer->events.reserve(bufferSize);
+    if (output)
+      writeThreadName(threadBuffer->id, "thread " + toString(threadBuffer->id));
+  }
+  return *threadBuffer;
+}
+
+// Both the buffer and the output must be locked.
+static void flush(ThreadBuffer& buffer) {
+  if (output)
+    for (auto& event : buffer.events)
+      *output << ",\n{\"name\": \"" << event.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer.id
+          << ", \"ts\": " << event.start << ", \"dur\": " << event.duration << "}";
+  buffer.events.clear();
+}
+
+void Tracer::start(std::ostream& out) {
+  std::unique_lock<std::mutex> lock(outputMutex);
+  CHECK(!output) << "Tracing already started";
+  output = &out;
+  startTime = steady_clock::now();
+  *output << "[{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"args\": {\"name\": \"KeeperRL\"}}";
+  // Threads that recorded zones in an earlier run keep their buffers and ids.
+  for (auto& buffer : buffers) {
+    std::unique_lock<std::mutex> lock(buffer->mutex);
+    buffer->events.clear();
+    writeThreadName(buffer->id, "thread " + toString(buffer->id));
+  }
+  enabled = true;
+}
+
+void Tracer::stop() {
+  std::unique_lock<std::mutex> lock(outputMutex);
+  if (!output)
+    return;
+  enabled = false;
+  for (auto& buffer : buffers) {
+    std::unique_lock<std::mutex> lock(buffer->mutex);
+    flush(*buffer);
+  }
+  *output << "\n]\n" << std::flush;
+  output = nullptr;
+}
+
+bool Tracer::isEnabled() {
+  return enabled;
+}
+
+void Tracer::setThreadName(const string& name) {
+  if (!enabled)
+    return;
+  ThreadBuffer& buffer = getThreadBuffer();
+  std::unique_lock<std::mutex> lock(outputMutex);
+  if (output)
+    writeThreadName(buffer.id, name);
+}
+
+Tracer::Zone::Zone(const char* n) : name(n), startMicros(enabled ? getMicros() : -1) {
+}
+
+Tracer::Zone::~Zone() {
+  if (startMicros < 0 || !enabled)
+    return;
+  ThreadBuffer& buffer = getThreadBuffer();
+  std::unique_lock<std::mutex> lock(buffer.mutex);
+  buffer.events.push_back({name, startMicros, getMicros() - startMicros});
+  if (buffer.events.size() >= bufferSize) {
+    lock.unlock();
+    std::unique_lock<std::mutex> outputLock(outputMutex);
+    std::unique_lock<std::mutex> bufferLock(buffer.mutex);
+    flush(buffer);
+  }
+}
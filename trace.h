@@ -0,0 +1,35 @@
+#pragma once
+
+#include "util.h"
+
+// Records scoped zones from all threads as Chrome Trace Event JSON, which can be opened in chrome://tracing
+// or Perfetto. Each thread gets its own track. Nothing is recorded unless tracing was started.
+class Tracer {
+  public:
+  // Zones are written to the stream until stop is called, which must happen before the stream is destroyed.
+  static void start(std::ostream&);
+  static void stop();
+  static bool isEnabled();
+  // Names the track of the calling thread.
+  static void setThreadName(const string&);
+
+  class Zone {
+    public:
+    // The name must outlive the tracing, normally it's a string literal.
+    Zone(const char* name);
+    ~Zone();
+
+    private:
+    const char* name;
+    long long startMicros;
+  };
+};
+
+#define TRACE_CONCAT2(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT2(a, b)
+
+#ifdef RELEASE
+#define TRACE_ZONE(name)
+#else
+#define TRACE_ZONE(name) Tracer::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#endif
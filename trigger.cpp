@@ -72,6 +72,7 @@ bool Trigger::interceptsFlyingItem(Item* it) const { return false; }
 void Trigger::onInterceptFlyingItem(vector<PItem> it, const Attack& a, int remainingDist, Vec2 dir, VisionId) {}
 bool Trigger::isDangerous(const Creature* c) const { return false; }
 void Trigger::tick() {}
+bool Trigger::needsTick() const { return false; }
 
 namespace {
 
@@ -138,6 +139,10 @@ class Portal : public Trigger {
     }
   }
 
+  virtual bool needsTick() const override {
+    return true;
+  }
+
   SERIALIZE_ALL2(Trigger, startTime, active);
   SERIALIZATION_CONSTRUCTOR(Portal);
 
@@ -249,6 +254,10 @@ class MeteorShower : public Trigger {
           break;
   }
 
+  virtual bool needsTick() const override {
+    return true;
+  }
+
   const int areaWidth = 3;
   const int range = 4;
 
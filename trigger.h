@@ -36,6 +36,8 @@ class Trigger {
 
   virtual bool isDangerous(const Creature* c) const;
   virtual void tick();
+  // Triggers with a time-dependent effect keep their square ticking.
+  virtual bool needsTick() const;
   virtual void fireDamage(double size);
   virtual double getLightEmission() const;
 
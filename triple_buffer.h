@@ -0,0 +1,41 @@
+#pragma once
+
+#include "stdafx.h"
+
+// Hands values over from one producer thread to one consumer thread without locks. The producer fills the back
+// buffer and publishes it, the consumer takes the most recently published value. Each side owns its buffer
+// until it publishes or consumes again, so neither of them ever waits for the other.
+template <typename T>
+class TripleBuffer {
+  public:
+  // Producer side.
+  T& getBack() {
+    return buffers[back];
+  }
+
+  void publish() {
+    back = middle.exchange(back | freshBit) & indexMask;
+  }
+
+  // True if the consumer took the last published value, or nothing was published yet.
+  bool wasConsumed() const {
+    return !(middle.load() & freshBit);
+  }
+
+  // Consumer side. Returns the published value if it wasn't taken yet, the pointer is valid until the next call.
+  T* consume() {
+    if (wasConsumed())
+      return nullptr;
+    front = middle.exchange(front) & indexMask;
+    return &buffers[front];
+  }
+
+  private:
+  static const int indexMask = 3;
+  static const int freshBit = 4;
+  array<T, 3> buffers;
+  int back = 0;
+  int front = 1;
+  // Index of the buffer that was published, and whether it was consumed yet.
+  atomic<int> middle {2};
+};
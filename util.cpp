@@ -87,7 +87,7 @@ double RandomGen::getDouble(double a, double b) {
   return uniform_real_distribution<double>(a, b)(generator);
 }
 
-RandomGen Random;
+thread_local RandomGen Random;
 
 template string toString<int>(const int&);
 template string toString<unsigned int>(const unsigned int&);
@@ -833,6 +833,18 @@ void Semaphore::v() {
   cond.notify_one();
 }
 
+#ifdef OSX // see thread comment in stdafx.h
+thread makeThread(function<void()> fun) {
+  thread::attributes attr;
+  attr.set_stack_size(4096 * 4000);
+  return thread(attr, fun);
+}
+#else
+thread makeThread(function<void()> fun) {
+  return thread(fun);
+}
+#endif
+
 AsyncLoop::AsyncLoop(function<void()> f) : AsyncLoop([]{}, f) {
 }
 
@@ -945,6 +957,8 @@ DisjointSets::DisjointSets(int s) : father(s), size(s, 1) {
 void DisjointSets::join(int i, int j) {
   i = getSet(i);
   j = getSet(j);
+  if (i == j)
+    return;
   if (size[i] < size[j])
     swap(i, j);
   father[j] = i;
@@ -257,12 +257,14 @@ class Range {
   Iter end();
 
   SERIALIZATION_DECL(Range)
-  HASH_ALL(start, finish, increment)
   
   private:
   int SERIAL(start) = 0; // HASH(start)
   int SERIAL(finish) = 0; // HASH(finish)
   int SERIAL(increment) = 1; // HASH(increment)
+
+  public:
+  HASH_ALL(start, finish, increment)
 };
 
 class Rectangle {
@@ -613,7 +615,8 @@ class RandomGen {
   }
 };
 
-extern RandomGen Random;
+// Each thread has its own generator, so that levels can be generated on several threads at once.
+extern thread_local RandomGen Random;
 
 inline std::ostream& operator <<(std::ostream& d, Rectangle rect) {
   return d << "(" << rect.left() << "," << rect.top() << ") (" << rect.right() << "," << rect.bottom() << ")";
@@ -1483,6 +1486,9 @@ class SyncQueue {
   queue<T> q;
 };
 
+// Uses a large stack on OSX, where secondary threads get only 512KB by default.
+thread makeThread(function<void()>);
+
 class AsyncLoop {
   public:
   AsyncLoop(function<void()> init, function<void()> loop);
@@ -1534,9 +1540,9 @@ class DisjointSets {
   void join(int, int);
   bool same(int, int);
   bool same(const vector<int>&);
+  int getSet(int);
 
   private:
-  int getSet(int);
   vector<int> father;
   vector<int> size;
 };
@@ -142,6 +142,13 @@ class View {
   /** Returns real-time game mode speed measured in turns per millisecond. **/
   virtual double getGameSpeed() = 0;
 
+  /** Returns whether the real-time game should run as fast as possible, refreshing the screen only
+      occasionally. Ignored while the clock is stopped.*/
+  virtual bool isTurboMode() = 0;
+
+  /** Switches from turbo mode back to the fastest regular speed.*/
+  virtual void stopTurboMode() = 0;
+
   /** Reads the game state from \paramname{creatureView}. If \paramname{noRefresh} is set,
       won't trigger screen to refresh.*/
   virtual void updateView(CreatureView*, bool noRefresh) = 0;
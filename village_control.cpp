@@ -67,6 +67,18 @@ void VillageControl::onMemberKilled(const Creature* victim, const Creature* kill
     victims += 1;
 }
 
+EnumSet<EventId> VillageControl::getSubscribedEvents() const {
+  return {EventId::PICKED_UP};
+}
+
+EnumSet<EventId> VillageControl::getDeferredEvents() const {
+  return {};
+}
+
+bool VillageControl::isInAreaOfInterest(EventId, Position pos) const {
+  return getCollective()->getTerritory().contains(pos);
+}
+
 void VillageControl::onEvent(const GameEvent& event) {
   switch (event.getId()) {
     case EventId::PICKED_UP: {
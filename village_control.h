@@ -45,6 +45,9 @@ class VillageControl : public CollectiveControl {
   HeapAllocated<EventProxy<VillageControl>> SERIAL(eventProxy);
   friend EventProxy<VillageControl>;
   void onEvent(const GameEvent&);
+  EnumSet<EventId> getSubscribedEvents() const;
+  EnumSet<EventId> getDeferredEvents() const;
+  bool isInAreaOfInterest(EventId, Position) const;
 
   void launchAttack(vector<Creature*> attackers);
   void considerWelcomeMessage();
@@ -17,6 +17,7 @@
 
 
 #include "window_view.h"
+#include "trace.h"
 #include "logging_view.h"
 #include "replay_view.h"
 #include "level.h"
@@ -203,15 +204,20 @@ void WindowView::mapRightClickFun(Vec2 pos) {
 }
 
 void WindowView::reset() {
-  RecursiveLock lock(renderMutex);
-  mapLayout = &currentTileLayout.layouts[0];
-  gameReady = false;
-  wasRendered = false;
-  minimapGui->clear();
-  mapGui->clearCenter();
-  guiBuilder.reset();
-  gameInfo = GameInfo{};
+  mapSnapshotMaker.reset();
+  minimapSnapshotMaker.reset();
   soundQueue.clear();
+  addVoidDialog([this] {
+    // Drop a frame of the previous game that wasn't applied yet.
+    frames.consume();
+    mapLayout = &currentTileLayout.layouts[0];
+    gameReady = false;
+    minimapGui->clear();
+    mapGui->clearCenter();
+    mapGui->clearLevelCache();
+    guiBuilder.reset();
+    gameInfo = GameInfo{};
+  });
 }
 
 void WindowView::displayOldSplash() {
@@ -532,27 +538,39 @@ void WindowView::drawLevelMap(const CreatureView* creature) {
         [this](double x, double y) { mapGui->setCenter(x, y);}); });
 }
 
-void WindowView::updateMinimap(const CreatureView* creature) {
-  const Level* level = creature->getLevel();
+Rectangle WindowView::getMinimapArea() const {
   Vec2 rad(40, 40);
   Vec2 playerPos = mapGui->getScreenPos().div(mapLayout->getSquareSize());
-  Rectangle bounds(playerPos - rad, playerPos + rad);
-  minimapGui->update(level, bounds, creature, true);
+  return Rectangle(playerPos - rad, playerPos + rad);
+}
+
+void WindowView::updateMinimap(const CreatureView* creature) {
+  minimapGui->update(creature->getLevel(), getMinimapArea(), creature, true);
 }
 
 void WindowView::updateView(CreatureView* view, bool noRefresh) {
-  if (!wasRendered && currentThreadId() != renderThreadId)
+  if (!noRefresh)
+    uiLock = false;
+  if (currentThreadId() != renderThreadId) {
+    // The game only hands over a snapshot and the render thread applies it in refreshView. A newer frame is not
+    // made until the last one is taken, the positions that changed meanwhile are collected by the next one.
+    if (!frames.wasConsumed())
+      return;
+    view->refreshGameInfo(refreshedInfo);
+    FrameSnapshot& frame = frames.getBack();
+    frame.gameInfo = refreshedInfo;
+    mapSnapshotMaker.fill(frame.map, view);
+    minimapSnapshotMaker.fill(frame.minimap, view->getLevel(), view, true);
+    frame.sounds = popSounds(view->getLevel());
+    frames.publish();
     return;
-  GameInfo newInfo;
-  view->refreshGameInfo(newInfo);
+  }
+  view->refreshGameInfo(refreshedInfo);
   RecursiveLock lock(renderMutex);
-  wasRendered = false;
   guiBuilder.addUpsCounterTick();
   gameReady = true;
-  if (!noRefresh)
-    uiLock = false;
   switchTiles();
-  gameInfo = newInfo;
+  gameInfo = refreshedInfo;
   rebuildGui();
   mapGui->setSpriteMode(currentTileLayout.sprites);
   bool spectator = gameInfo.infoType == GameInfo::InfoType::SPECTATOR;
@@ -561,22 +579,46 @@ void WindowView::updateView(CreatureView* view, bool noRefresh) {
   if (gameInfo.infoType == GameInfo::InfoType::SPECTATOR)
     guiBuilder.setGameSpeed(GuiBuilder::GameSpeed::NORMAL);
   if (soundLibrary)
-    playSounds(view);
+    playSounds(popSounds(view->getLevel()));
 }
 
-void WindowView::playSounds(const CreatureView* view) {
+void WindowView::applyFrame(FrameSnapshot& frame) {
+  guiBuilder.addUpsCounterTick();
+  gameReady = true;
+  switchTiles();
+  gameInfo = frame.gameInfo;
+  rebuildGui();
+  mapGui->setSpriteMode(currentTileLayout.sprites);
+  bool spectator = gameInfo.infoType == GameInfo::InfoType::SPECTATOR;
+  mapGui->updateObjects(frame.map, mapLayout, currentTileLayout.sprites || spectator, !spectator);
+  minimapGui->update(frame.minimap, getMinimapArea());
+  if (spectator)
+    guiBuilder.setGameSpeed(GuiBuilder::GameSpeed::NORMAL);
+  if (soundLibrary)
+    playSounds(frame.sounds);
+}
+
+vector<Sound> WindowView::popSounds(const Level* level) {
+  vector<Sound> ret;
+  for (auto& sound : soundQueue)
+    if (!sound.getPosition() || sound.getPosition()->isSameLevel(level))
+      ret.push_back(sound);
+  soundQueue.clear();
+  return ret;
+}
+
+void WindowView::playSounds(const vector<Sound>& sounds) {
   Rectangle area = mapLayout->getAllTiles(getMapGuiBounds(), Level::getMaxBounds(), mapGui->getScreenPos());
   auto curTime = clock->getRealMillis();
   const milliseconds soundCooldown {70};
-  for (auto& sound : soundQueue) {
+  for (auto& sound : sounds) {
     auto lastTime = lastPlayed[sound.getId()];
     if ((!lastTime || curTime > *lastTime + soundCooldown) && (!sound.getPosition() ||
-        (sound.getPosition()->isSameLevel(view->getLevel()) && sound.getPosition()->getCoord().inRectangle(area)))) {
+        sound.getPosition()->getCoord().inRectangle(area))) {
       soundLibrary->playSound(sound);
       lastPlayed[sound.getId()] = curTime;
     }
   }
-  soundQueue.clear();
 }
 
 void WindowView::animateObject(vector<Vec2> trajectory, ViewObject object) {
@@ -602,10 +644,8 @@ void WindowView::refreshView() {
     return;
   {
     RecursiveLock lock(renderMutex);
-/*    if (!wasRendered && gameReady)
-      rebuildGui();*/
-    wasRendered = true;
-    CHECK(currentThreadId() == renderThreadId);
+    if (auto frame = frames.consume())
+      applyFrame(*frame);
     if (gameReady || !blockingElems.empty())
       processEvents();
     if (!renderDialog.empty())
@@ -630,6 +670,7 @@ void WindowView::drawMap() {
 }
 
 void WindowView::refreshScreen(bool flipBuffer) {
+  TRACE_ZONE("WindowView::refreshScreen");
   {
     RecursiveLock lock(renderMutex);
     if (fullScreenTrigger > -1) {
@@ -1359,10 +1400,20 @@ double WindowView::getGameSpeed() {
     case GuiBuilder::GameSpeed::SLOW: return 0.015;
     case GuiBuilder::GameSpeed::NORMAL: return 0.025;
     case GuiBuilder::GameSpeed::FAST: return 0.04;
-    case GuiBuilder::GameSpeed::VERY_FAST: return 0.06;
+    case GuiBuilder::GameSpeed::VERY_FAST:
+    case GuiBuilder::GameSpeed::TURBO: return 0.06;
   }
 }
 
+bool WindowView::isTurboMode() {
+  return guiBuilder.getGameSpeed() == GuiBuilder::GameSpeed::TURBO;
+}
+
+void WindowView::stopTurboMode() {
+  if (isTurboMode())
+    guiBuilder.setGameSpeed(GuiBuilder::GameSpeed::VERY_FAST);
+}
+
 void WindowView::addSound(const Sound& sound) {
   soundQueue.push_back(sound);
 }
@@ -23,13 +23,14 @@
 #include "gui_builder.h"
 #include "clock.h"
 #include "sound.h"
+#include "map_gui.h"
+#include "minimap_gui.h"
+#include "triple_buffer.h"
 
 class SoundLibrary;
 class ViewIndex;
 class Options;
 class Clock;
-class MinimapGui;
-class MapGui;
 
 /** See view.h for documentation.*/
 class WindowView: public View {
@@ -68,6 +69,8 @@ class WindowView: public View {
   virtual void animateObject(vector<Vec2> trajectory, ViewObject object) override;
   virtual void animation(Vec2 pos, AnimationId) override;
   virtual double getGameSpeed() override;
+  virtual bool isTurboMode() override;
+  virtual void stopTurboMode() override;
 
   virtual void presentText(const string& title, const string& text) override;
   virtual void presentList(const string& title, const vector<ListElem>& options, bool scrollDown = false,
@@ -106,6 +109,7 @@ class WindowView: public View {
   void displayMenuSplash2();
   void displayOldSplash();
   void updateMinimap(const CreatureView*);
+  Rectangle getMinimapArea() const;
   void mapContinuousLeftClickFun(Vec2);
   void mapCreatureClickFun(UniqueEntity<Creature>::Id);
   void mapCreatureDragFun(UniqueEntity<Creature>::Id, ViewId, Vec2 origin);
@@ -143,6 +147,8 @@ class WindowView: public View {
   bool oldMessage = false;
 
   GameInfo gameInfo;
+  // Filled in place by the CreatureView, which only regenerates the sections that changed.
+  GameInfo refreshedInfo;
 
   MapLayout* mapLayout;
   shared_ptr<MapGui> mapGui;
@@ -158,7 +164,18 @@ class WindowView: public View {
   bool gameReady = false;
   atomic<bool> uiLock;
   atomic<bool> refreshInput;
-  atomic<bool> wasRendered;
+
+  // Everything updateView collects from the game when it runs on a different thread than rendering.
+  struct FrameSnapshot {
+    GameInfo gameInfo;
+    MapGui::Snapshot map;
+    MinimapGui::Snapshot minimap;
+    vector<Sound> sounds;
+  };
+  TripleBuffer<FrameSnapshot> frames;
+  MapGui::SnapshotMaker mapSnapshotMaker;
+  MinimapGui::SnapshotMaker minimapSnapshotMaker;
+  void applyFrame(FrameSnapshot&);
 
   struct TileLayouts {
     vector<MapLayout> layouts;
@@ -245,7 +262,8 @@ class WindowView: public View {
   atomic<int> fullScreenTrigger;
   atomic<int> fullScreenResolution;
   atomic<int> zoomUI;
-  void playSounds(const CreatureView*);
+  vector<Sound> popSounds(const Level*);
+  void playSounds(const vector<Sound>&);
   vector<Sound> soundQueue;
   EnumMap<SoundId, optional<milliseconds>> lastPlayed;
   SoundLibrary* soundLibrary;
@@ -0,0 +1,85 @@
+#include "stdafx.h"
+#include "worldgen_profiler.h"
+#include "level_maker.h"
+
+using namespace std::chrono;
+
+static thread_local WorldgenProfiler* currentProfiler = nullptr;
+
+WorldgenProfiler::WorldgenProfiler() {
+  clear();
+}
+
+WorldgenProfiler::Scope::Scope(WorldgenProfiler& profiler) : previous(currentProfiler) {
+  currentProfiler = &profiler;
+}
+
+WorldgenProfiler::Scope::~Scope() {
+  currentProfiler = previous;
+}
+
+WorldgenProfiler* WorldgenProfiler::getCurrent() {
+  return currentProfiler;
+}
+
+void WorldgenProfiler::measure(const string& name, function<void()> fun) {
+  auto& child = stack.back()->children[name];
+  if (!child)
+    child.reset(new Node());
+  Node* node = child.get();
+  stack.push_back(node);
+  propagatingFailure = false;
+  ++node->calls;
+  auto startTime = steady_clock::now();
+  auto finish = [&] {
+    node->millis += duration_cast<microseconds>(steady_clock::now() - startTime).count() / 1000.0;
+    stack.pop_back();
+  };
+  try {
+    fun();
+  } catch (LevelGenException) {
+    ++node->failures;
+    if (!propagatingFailure)
+      ++node->ownFailures;
+    propagatingFailure = true;
+    finish();
+    throw;
+  } catch (...) {
+    finish();
+    throw;
+  }
+  finish();
+}
+
+void WorldgenProfiler::clear() {
+  CHECK(stack.size() <= 1) << "Can't clear a running profiler";
+  root = Node();
+  stack = {&root};
+  propagatingFailure = false;
+}
+
+static string getIndent(int indent) {
+  return string(2 * indent, ' ');
+}
+
+void WorldgenProfiler::writeJson(std::ostream& out, const string& name, const Node& node, int indent) const {
+  out << "{\n" << getIndent(indent + 1) << "\"name\": \"" << name << "\",\n"
+      << getIndent(indent + 1) << "\"calls\": " << node.calls << ",\n"
+      << getIndent(indent + 1) << "\"failures\": " << node.failures << ",\n"
+      << getIndent(indent + 1) << "\"ownFailures\": " << node.ownFailures << ",\n"
+      << getIndent(indent + 1) << "\"millis\": " << node.millis << ",\n"
+      << getIndent(indent + 1) << "\"children\": [";
+  bool first = true;
+  for (auto& child : node.children) {
+    out << (first ? "\n" : ",\n") << getIndent(indent + 2);
+    writeJson(out, child.first, *child.second, indent + 2);
+    first = false;
+  }
+  if (!first)
+    out << "\n" << getIndent(indent + 1);
+  out << "]\n" << getIndent(indent) << "}";
+}
+
+void WorldgenProfiler::writeJson(std::ostream& out) const {
+  writeJson(out, "root", root, 0);
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "util.h"
+
+// Attributes time and LevelGenExceptions to the nested LevelMakers that build a model.
+class WorldgenProfiler {
+  public:
+  WorldgenProfiler();
+
+  // LevelMakers running on this thread report to the given profiler while the Scope is alive.
+  class Scope {
+    public:
+    Scope(WorldgenProfiler&);
+    ~Scope();
+
+    private:
+    WorldgenProfiler* previous;
+  };
+
+  static WorldgenProfiler* getCurrent();
+
+  // Runs fun as a child of the innermost running node. Rethrows whatever fun throws.
+  void measure(const string& name, function<void()> fun);
+  void clear();
+  void writeJson(std::ostream&) const;
+
+  private:
+  struct Node {
+    int calls = 0;
+    // Calls that ended with a LevelGenException, and those where it was thrown by this node rather than a child.
+    int failures = 0;
+    int ownFailures = 0;
+    double millis = 0;
+    map<string, unique_ptr<Node>> children;
+  };
+  void writeJson(std::ostream&, const string& name, const Node&, int indent) const;
+  Node root;
+  vector<Node*> stack;
+  bool propagatingFailure = false;
+};